@@ -0,0 +1,202 @@
+#include "BatchInferenceEngine.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+BatchInferenceEngine::BatchInferenceEngine(std::shared_ptr<Inference> inference,
+                                           int maxBatchSize,
+                                           int maxWaitMs)
+    : BatchInferenceEngine(std::make_shared<InferencePool>(inference), maxBatchSize, maxWaitMs) {
+}
+
+BatchInferenceEngine::BatchInferenceEngine(std::shared_ptr<InferencePool> pool,
+                                           int maxBatchSize,
+                                           int maxWaitMs)
+    : pool_(pool),
+      maxBatchSize_(std::max(1, maxBatchSize)),
+      maxWaitMs_(std::max(0, maxWaitMs)),
+      stopping_(false),
+      batchesRun_(0),
+      framesRun_(0) {
+    int workerCount = pool_ ? pool_->size() : 1;
+    for (int i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&BatchInferenceEngine::workerLoop, this, i);
+    }
+
+    std::cout << "BatchInference: started " << workerCount << " worker(s) (max batch "
+              << maxBatchSize_ << ", max wait " << maxWaitMs_ << "ms)" << std::endl;
+}
+
+BatchInferenceEngine::~BatchInferenceEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Release anyone still waiting on a frame that never made it into a batch
+    for (auto& request : pending_) {
+        request.done({}, nullptr);
+    }
+    pending_.clear();
+}
+
+std::future<std::vector<Detection>> BatchInferenceEngine::submit(int cameraId, const cv::Mat& frame) {
+    auto promise = std::make_shared<std::promise<std::vector<Detection>>>();
+    std::future<std::vector<Detection>> future = promise->get_future();
+
+    submit(cameraId, frame, [promise](std::vector<Detection> detections, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(detections));
+        }
+    });
+    return future;
+}
+
+void BatchInferenceEngine::submit(int cameraId, const cv::Mat& frame, Callback done) {
+    Callback replaced;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = std::find_if(pending_.begin(), pending_.end(),
+                               [cameraId](const Request& r) { return r.cameraId == cameraId; });
+
+        if (it != pending_.end()) {
+            // Latest frame wins: the caller has abandoned the older request
+            replaced = std::move(it->done);
+            it->frame = frame;
+            it->done = std::move(done);
+        } else {
+            pending_.push_back(Request{cameraId, frame, std::move(done),
+                                       std::chrono::steady_clock::now()});
+        }
+    }
+    condition_.notify_all();
+
+    if (replaced) {
+        replaced({}, nullptr);
+    }
+}
+
+void BatchInferenceEngine::setInference(std::shared_ptr<Inference> inference) {
+    setPool(std::make_shared<InferencePool>(inference));
+}
+
+void BatchInferenceEngine::setPool(std::shared_ptr<InferencePool> pool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_ = pool;
+}
+
+void BatchInferenceEngine::setMaxBatchSize(int maxBatchSize) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxBatchSize_ = std::max(1, maxBatchSize);
+    }
+    condition_.notify_all();
+}
+
+int BatchInferenceEngine::getMaxBatchSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxBatchSize_;
+}
+
+void BatchInferenceEngine::setMaxWaitMs(int maxWaitMs) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        maxWaitMs_ = std::max(0, maxWaitMs);
+    }
+    condition_.notify_all();
+}
+
+int BatchInferenceEngine::getMaxWaitMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxWaitMs_;
+}
+
+double BatchInferenceEngine::getAverageBatchSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batchesRun_ > 0 ? static_cast<double>(framesRun_) / batchesRun_ : 0.0;
+}
+
+void BatchInferenceEngine::workerLoop(int workerIndex) {
+    while (true) {
+        std::vector<Request> batch;
+        std::shared_ptr<Inference> inference;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            // Wait for the first frame
+            condition_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (stopping_) {
+                return;
+            }
+
+            // Give other cameras until the oldest frame's deadline to join the batch
+            auto deadline = pending_.front().enqueuedAt + std::chrono::milliseconds(maxWaitMs_);
+            condition_.wait_until(lock, deadline, [this]() {
+                return stopping_ || static_cast<int>(pending_.size()) >= maxBatchSize_;
+            });
+            if (stopping_) {
+                return;
+            }
+            if (pending_.empty()) {
+                continue;  // Another worker took the batch
+            }
+            if (static_cast<int>(pending_.size()) < maxBatchSize_ &&
+                std::chrono::steady_clock::now() <
+                    pending_.front().enqueuedAt + std::chrono::milliseconds(maxWaitMs_)) {
+                continue;  // Queue front changed while waiting; restart on its deadline
+            }
+
+            size_t count = std::min(pending_.size(), static_cast<size_t>(maxBatchSize_));
+            batch.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(pending_.front()));
+                pending_.pop_front();
+            }
+            if (pool_) {
+                inference = pool_->getInstance(workerIndex % pool_->size());
+            }
+        }
+
+        std::vector<cv::Mat> frames;
+        frames.reserve(batch.size());
+        for (const auto& request : batch) {
+            frames.push_back(request.frame);
+        }
+
+        std::vector<std::vector<Detection>> results;
+        std::exception_ptr error;
+        try {
+            if (!inference) {
+                throw std::runtime_error("no model loaded");
+            }
+            results = inference->runInferenceBatch(frames);
+        } catch (...) {
+            std::cerr << "BatchInference: batch of " << batch.size() << " frame(s) failed" << std::endl;
+            error = std::current_exception();
+        }
+
+        // Outside the try: a throwing callback must not complete the other requests twice
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (error) {
+                batch[i].done({}, error);
+            } else {
+                batch[i].done(std::move(results[i]), nullptr);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        batchesRun_++;
+        framesRun_ += static_cast<long long>(batch.size());
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef BATCHINFERENCEENGINE_H
+#define BATCHINFERENCEENGINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+#include "inference.h"
+#include "InferencePool.h"
+
+/**
+ * @brief Cross-camera batching service built around a shared Inference
+ *
+ * Cameras submit their latest frame and receive a future for the detections.
+ * A worker thread gathers pending frames from all cameras until either
+ * maxBatchSize frames are queued or maxWaitMs has passed since the oldest
+ * one arrived, then runs them through a single forward pass
+ * (Inference::runInferenceBatch) and scatters the results back.
+ *
+ * When built on an InferencePool, one worker thread runs per pool instance,
+ * so several batches can be in flight on different cores at once.
+ *
+ * Results come back through a future, or through a callback for callers
+ * that must not block on one (tasks on the shared TaskScheduler).
+ *
+ * Each camera is expected to keep at most one request in flight; if a camera
+ * submits again before its previous frame was batched, the older frame is
+ * replaced by the newer one so the batch always holds the latest frames.
+ */
+class BatchInferenceEngine {
+public:
+    explicit BatchInferenceEngine(std::shared_ptr<Inference> inference,
+                                  int maxBatchSize = 8,
+                                  int maxWaitMs = 10);
+    explicit BatchInferenceEngine(std::shared_ptr<InferencePool> pool,
+                                  int maxBatchSize = 8,
+                                  int maxWaitMs = 10);
+    ~BatchInferenceEngine();
+
+    // Delete copy/move constructors and assignment operators
+    BatchInferenceEngine(const BatchInferenceEngine&) = delete;
+    BatchInferenceEngine& operator=(const BatchInferenceEngine&) = delete;
+
+    /**
+     * @brief Queue a frame for the next batch
+     * @param cameraId Camera that owns the frame
+     * @param frame Frame to run detection on (shared, not copied)
+     * @return Future resolved with the detections for this frame
+     */
+    std::future<std::vector<Detection>> submit(int cameraId, const cv::Mat& frame);
+
+    // Called on a batch worker thread with the detections, or with the batch's exception
+    using Callback = std::function<void(std::vector<Detection> detections, std::exception_ptr error)>;
+
+    /**
+     * @brief Queue a frame and call `done` when its batch has run
+     *
+     * `done` runs on the worker that ran the batch and should only hand the
+     * result on. A request replaced by a newer frame of the same camera
+     * completes with no detections.
+     */
+    void submit(int cameraId, const cv::Mat& frame, Callback done);
+
+    /**
+     * @brief Swap the model used for subsequent batches
+     *
+     * Takes effect from the next batch; batches already running finish on
+     * the old model. The number of worker threads is fixed at construction,
+     * workers map onto the new pool's instances round-robin.
+     */
+    void setInference(std::shared_ptr<Inference> inference);
+    void setPool(std::shared_ptr<InferencePool> pool);
+
+    // Batching parameters
+    void setMaxBatchSize(int maxBatchSize);
+    int getMaxBatchSize() const;
+    void setMaxWaitMs(int maxWaitMs);
+    int getMaxWaitMs() const;
+
+    // Statistics
+    double getAverageBatchSize() const;
+
+private:
+    struct Request {
+        int cameraId;
+        cv::Mat frame;
+        Callback done;
+        std::chrono::steady_clock::time_point enqueuedAt;
+    };
+
+    void workerLoop(int workerIndex);
+
+    std::shared_ptr<InferencePool> pool_;
+    int maxBatchSize_;
+    int maxWaitMs_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Request> pending_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+
+    // Accumulated batch statistics
+    long long batchesRun_;
+    long long framesRun_;
+};
+
+#endif // BATCHINFERENCEENGINE_H
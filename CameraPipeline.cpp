@@ -0,0 +1,956 @@
+#include "CameraPipeline.h"
+#include "yolo_to_bytetrack.h"
+#include "ClassFilterManager.h"
+#include "EventManager.h"
+#include "RegionCountManager.h"
+#include "TelegramBot.h"
+#include "FrameBus.h"
+#include <QDateTime>
+#include <QPixmap>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+// Frames waiting for or in the track/annotate strand; beyond this the grabber drops frames
+constexpr int kMaxBacklog = 2;
+
+// How often the GUI thread looks at the connection state
+constexpr int kConnectionPollMs = 200;
+
+// Frames between two crops of the same track sent to the realtime panel (once per second at 30 fps)
+constexpr int kCropEmitInterval = 30;
+
+// Dual-stream cameras: a main-stream frame further apart from the processed frame is not used for events
+constexpr int kMainFrameMaxSkewMs = 500;
+
+// Runs `release` when the scope ends unless dismissed. Stage tasks hold their flow slot in one, so a
+// stage that throws (the scheduler logs and carries on) cannot leave stop() waiting forever.
+class ScopeGuard {
+public:
+    explicit ScopeGuard(std::function<void()> release) : release_(std::move(release)) {}
+    ~ScopeGuard() {
+        if (release_) {
+            release_();
+        }
+    }
+    ScopeGuard(const ScopeGuard&) = delete;
+    ScopeGuard& operator=(const ScopeGuard&) = delete;
+
+    // The slot was handed on to a stage that releases it itself
+    void dismiss() { release_ = nullptr; }
+
+private:
+    std::function<void()> release_;
+};
+
+} // namespace
+
+CameraPipeline::CameraPipeline(std::shared_ptr<CameraSource> camera,
+                               std::shared_ptr<Inference> inference,
+                               QObject* parent)
+    : QObject(parent), camera_(camera), cameraName_(camera->getName()),
+      inference_(inference), drawnRegions_(std::make_shared<const std::vector<Region>>()),
+      regions_(drawnRegions_) {
+
+    qRegisterMetaType<PipelineStats>("PipelineStats");
+    qRegisterMetaType<FrameGrabber::ConnectionState>("FrameGrabber::ConnectionState");
+
+    TaskScheduler& scheduler = TaskScheduler::getInstance();
+    frontStrand_ = scheduler.makeStrand();
+    backStrand_ = scheduler.makeStrand();
+
+    connectionTimer_ = new QTimer(this);
+    connect(connectionTimer_, &QTimer::timeout, this, &CameraPipeline::checkConnection);
+
+    // A finished source stops the pipeline even with no widget attached
+    connect(this, &CameraPipeline::sourceFailed, this, &CameraPipeline::stop, Qt::QueuedConnection);
+}
+
+CameraPipeline::~CameraPipeline() {
+    stop();
+}
+
+bool CameraPipeline::start() {
+    if (isRunning()) {
+        return true;
+    }
+
+    if (!camera_->isOpened() && !camera_->open()) {
+        return false;
+    }
+
+    // Forward passes never run on the pipeline workers; without a shared engine this camera gets its own
+    if (!batchEngine_) {
+        setBatchInferenceEngine(nullptr);
+    }
+
+    connectionState_ = FrameGrabber::ConnectionState::Disconnected;
+    outagePending_.store(false, std::memory_order_relaxed);
+    // start() runs on the display consumer's thread; a frame left over from the last run is not shown
+    QImage stale;
+    display_.read(stale);
+    displayNotified_.store(false, std::memory_order_release);
+    statsWindowStart_ = std::chrono::steady_clock::now();
+    statsWindowFrames_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_ = PipelineStats();
+    }
+
+    running_.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        accepting_ = true;
+    }
+
+    // Frames are pulled by the stage tasks; the capture thread only says one is there
+    camera_->setFrameListener([this]() { pump(); });
+    connectionTimer_->start(kConnectionPollMs);
+    pump();
+    return true;
+}
+
+void CameraPipeline::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    connectionTimer_->stop();
+    camera_->setFrameListener(nullptr);
+
+    // Let the frames in flight finish; their tasks use this object
+    {
+        std::unique_lock<std::mutex> lock(flowMutex_);
+        accepting_ = false;
+        flowIdle_.wait(lock, [this]() { return !frontBusy_ && backlog_ == 0 && cropTasks_ == 0; });
+    }
+
+    camera_->close();
+    mainFrame_ = CapturedFrame();
+    activeTrackCount_.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        scheduler_.reset();
+    }
+
+    std::lock_guard<std::mutex> lock(motionGateMutex_);
+    if (motionGate_.getConfig().enabled) {
+        uint64_t total = motionGate_.getInferredFrames() + motionGate_.getSkippedFrames();
+        std::cout << "Camera '" << cameraName_ << "': motion gate skipped "
+                  << motionGate_.getSkippedFrames() << " of " << total << " frames" << std::endl;
+    }
+    motionGate_.reset();
+}
+
+void CameraPipeline::setInference(std::shared_ptr<Inference> inference) {
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    inference_ = inference;
+    if (ownsEngine_) {
+        batchEngine_->setInference(inference);
+    }
+    // The track stage clears its track -> class map: the new model might have different classes
+    inferenceChanged_.store(true, std::memory_order_release);
+}
+
+void CameraPipeline::setBatchInferenceEngine(std::shared_ptr<BatchInferenceEngine> engine) {
+    bool ownEngine = !engine;
+    if (ownEngine) {
+        std::shared_ptr<Inference> inference;
+        {
+            std::lock_guard<std::mutex> lock(settingsMutex_);
+            inference = inference_;
+        }
+        engine = std::make_shared<BatchInferenceEngine>(inference, 1, 0);
+    }
+
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    batchEngine_ = engine;
+    ownsEngine_ = ownEngine;
+}
+
+void CameraPipeline::setDetectionSchedule(const DetectionScheduler::Config& config) {
+    std::lock_guard<std::mutex> lock(schedulerMutex_);
+    scheduler_.setConfig(config);
+}
+
+void CameraPipeline::setMotionGate(const MotionGate::Config& config) {
+    std::lock_guard<std::mutex> lock(motionGateMutex_);
+    motionGate_.setConfig(config);
+}
+
+void CameraPipeline::setRoiInference(bool enabled, float marginRatio) {
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    roiInferenceEnabled_ = enabled;
+    roiMarginRatio_ = std::max(0.0f, marginRatio);
+}
+
+void CameraPipeline::setRegions(const std::vector<Region>& regions) {
+    // Frames already in flight keep the regions they were preprocessed with
+    auto snapshot = std::make_shared<const std::vector<Region>>(regions);
+    std::lock_guard<std::mutex> lock(settingsMutex_);
+    drawnRegions_ = snapshot;
+    regions_ = snapshot;
+    regionsFrameSize_ = cv::Size();  // Mapped to the frame size again by the next preprocessed frame
+}
+
+std::shared_ptr<const std::vector<Region>> CameraPipeline::fitRegions(const std::vector<Region>& regions,
+                                                                     const cv::Size& frameSize) const {
+    auto fitted = std::make_shared<std::vector<Region>>();
+    cv::Rect frameRect(0, 0, frameSize.width, frameSize.height);
+    for (const Region& region : regions) {
+        fitted->push_back(region.scaledTo(frameSize));
+
+        // Regions saved before the drawing size was recorded cannot be rescaled
+        cv::Rect box = region.getBoundingBox();
+        if (region.getFrameSize().empty() && (box & frameRect) != box) {
+            std::cerr << "⚠️  Camera '" << cameraName_ << "': region '" << region.getName()
+                      << "' extends outside the " << frameSize.width << "x" << frameSize.height
+                      << " frame; it was probably drawn on another stream (e.g. the main stream"
+                      << " before a substream was set) and should be redrawn" << std::endl;
+        }
+    }
+    return fitted;
+}
+
+PipelineStats CameraPipeline::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+bool CameraPipeline::takeDisplayFrame(QImage& image) {
+    // Answer the notification before reading: pairs with the exchange after the write,
+    // so a frame written after this read raises a new notification
+    displayNotified_.exchange(false, std::memory_order_acq_rel);
+    return display_.read(image);
+}
+
+void CameraPipeline::checkConnection() {
+    FrameGrabber::ConnectionState state = camera_->getConnectionState();
+    if (state != connectionState_) {
+        if (state == FrameGrabber::ConnectionState::Connected &&
+            connectionState_ == FrameGrabber::ConnectionState::Reconnecting) {
+            std::cout << "Camera '" << cameraName_ << "' back after "
+                      << camera_->getLastOutageMs() << " ms outage (" << camera_->getOutageCount()
+                      << " so far)" << std::endl;
+            outagePending_.store(true, std::memory_order_release);
+        }
+        connectionState_ = state;
+        emit connectionStateChanged(state);
+    }
+
+    // A frame published just before the thread failed is still processed first
+    if (camera_->hasFailed() && !camera_->hasFreshFrame()) {
+        std::cout << "Camera '" << cameraName_ << "': source ended, stopping pipeline" << std::endl;
+        connectionTimer_->stop();
+        emit sourceFailed();
+    }
+}
+
+void CameraPipeline::pump() {
+    std::unique_lock<std::mutex> lock(flowMutex_);
+    pumpLocked(lock);
+}
+
+void CameraPipeline::pumpLocked(std::unique_lock<std::mutex>& lock) {
+    // Checked under the lock: the capture thread publishes before it pumps, so a frame
+    // that arrives while the front is busy is seen here when the front frees up
+    bool next = accepting_ && !frontBusy_ && backlog_ < kMaxBacklog && camera_->hasFreshFrame();
+    if (next) {
+        frontBusy_ = true;
+    }
+    flowIdle_.notify_all();
+    lock.unlock();
+
+    // Nothing below touches this object unless a frame was claimed, which keeps stop() waiting
+    if (next) {
+        frontStrand_->post([this]() { preprocessNext(); });
+    }
+}
+
+void CameraPipeline::releaseFront() {
+    std::unique_lock<std::mutex> lock(flowMutex_);
+    frontBusy_ = false;
+    pumpLocked(lock);
+}
+
+void CameraPipeline::preprocessNext() {
+    // Released here unless the frame moves on to infer() or the back strand
+    ScopeGuard frontClaim([this]() { releaseFront(); });
+
+    auto frame = std::make_shared<Frame>();
+    if (!camera_->grabLatest(frame->captured)) {
+        return;
+    }
+
+    frame->number = ++frameNumber_;
+    frame->afterOutage = outagePending_.exchange(false, std::memory_order_acq_rel);
+
+    bool roiEnabled;
+    float roiMargin;
+    {
+        std::lock_guard<std::mutex> lock(settingsMutex_);
+        frame->inference = inference_;
+        frame->batchEngine = batchEngine_;
+        if (regionsFrameSize_ != frame->captured.image.size()) {
+            // Regions are drawn on whatever stream was displayed; detection may run on another size
+            regionsFrameSize_ = frame->captured.image.size();
+            regions_ = fitRegions(*drawnRegions_, regionsFrameSize_);
+        }
+        frame->regions = regions_;
+        roiEnabled = roiInferenceEnabled_;
+        roiMargin = roiMarginRatio_;
+    }
+
+    bool detect;
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        if (frame->afterOutage) {
+            // Track velocities are stale after a gap; the tracker itself keeps its IDs
+            // so region counts are not repeated
+            scheduler_.reset();
+        }
+        detect = scheduler_.shouldDetect();
+    }
+
+    if (!detect) {
+        frame->mode = Mode::Predict;
+    } else {
+        std::lock_guard<std::mutex> lock(motionGateMutex_);
+        if (frame->afterOutage) {
+            motionGate_.reset();  // Reference frame is from before the outage
+        }
+        bool hasTracks = activeTrackCount_.load(std::memory_order_relaxed) > 0;
+        frame->mode = motionGate_.shouldInfer(frame->captured.image, *frame->regions, hasTracks)
+                          ? Mode::Detect : Mode::Static;
+    }
+
+    if (frame->mode != Mode::Detect) {
+        frontClaim.dismiss();
+        handOff(frame);
+        return;
+    }
+
+    frame->roi = inferenceRoi(frame->captured.image.size(), *frame->regions, roiEnabled, roiMargin);
+    frontClaim.dismiss();
+    infer(frame);
+}
+
+void CameraPipeline::infer(const std::shared_ptr<Frame>& frame) {
+    // Released here unless the frame reaches the back strand or the batch engine
+    ScopeGuard frontClaim([this]() { releaseFront(); });
+
+    // YOLO Detection (on the region crop when ROI inference is enabled)
+    auto start = std::chrono::steady_clock::now();
+    cv::Mat input = frame->captured.image(frame->roi);
+
+    // Completes on an engine thread; no scheduler worker waits for the forward pass.
+    // The engine calls back exactly once, also when it is destroyed with the request pending.
+    frame->batchEngine->submit(getCameraId(), input,
+        [this, frame, start](std::vector<Detection> detections, std::exception_ptr error) {
+            // Nothing may escape into the engine thread; a failed frame goes on without detections
+            try {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+                frame->detections = std::move(detections);
+                finishInference(*frame, start);
+            } catch (const std::exception& e) {
+                std::cerr << "Camera '" << cameraName_ << "': inference failed: " << e.what() << std::endl;
+                frame->detections.clear();
+            } catch (...) {
+                std::cerr << "Camera '" << cameraName_ << "': inference failed" << std::endl;
+                frame->detections.clear();
+            }
+            handOff(frame);
+        });
+    frontClaim.dismiss();
+}
+
+void CameraPipeline::finishInference(Frame& frame, std::chrono::steady_clock::time_point start) {
+    frame.inferenceMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        scheduler_.reportLatency(frame.inferenceMs);
+    }
+    offsetDetections(frame.detections, frame.roi.tl());
+}
+
+void CameraPipeline::handOff(const std::shared_ptr<Frame>& frame) {
+    {
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        backlog_++;
+    }
+
+    // Posted while the front is still held, so frames reach the back strand in order
+    backStrand_->post([this, frame]() { trackAndAnnotate(frame); });
+
+    std::unique_lock<std::mutex> lock(flowMutex_);
+    frontBusy_ = false;
+    pumpLocked(lock);
+}
+
+void CameraPipeline::trackAndAnnotate(const std::shared_ptr<Frame>& frame) {
+    // The frame leaves the back strand however this stage ends
+    ScopeGuard backlogSlot([this]() {
+        std::unique_lock<std::mutex> lock(flowMutex_);
+        backlog_--;
+        pumpLocked(lock);
+    });
+
+    if (inferenceChanged_.exchange(false, std::memory_order_acq_rel)) {
+        regionTracker_.clearTrackClasses();
+    }
+
+    if (frame->mode == Mode::Predict) {
+        // No detector run: the tracker still predicts this frame, region and event logic work on
+        // the extrapolated boxes (the tracker reports no boxes for a frame without detections)
+        regionTracker_.predict();
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        frame->tracks = scheduler_.predictTracks();
+    } else {
+        // Static frames keep the tracker ticking with an empty update
+        updateTracker(*frame);
+    }
+    refreshMainFrame(*frame);
+    updateRegions(*frame);
+
+    annotate(*frame);
+
+    // Full-screen views show this output instead of reading the camera and detecting again.
+    // The frame is shared, not copied, and nothing draws into it after this point.
+    FrameBus& bus = FrameBus::getInstance();
+    if (bus.hasSubscribers(getCameraId())) {
+        AnnotatedFrame annotated;
+        annotated.image = frame->captured.image;
+        annotated.frameNumber = static_cast<uint64_t>(frame->number);
+        annotated.trackCount = frame->tracks.size();
+        annotated.detectionCount = frame->detections.size();
+        annotated.regionCounts = frame->regionCounts;
+        bus.publish(getCameraId(), annotated);
+    }
+
+    emitCrops(frame);
+
+    // Newest frame wins; the GUI is told once and picks up whatever is newest by then
+    bool replaced = display_.write(cvMatToQImage(frame->captured.image));
+    if (!displayNotified_.exchange(true, std::memory_order_acq_rel)) {
+        emit displayFrameAvailable();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.framesProcessed++;
+        stats_.trackCount = frame->tracks.size();
+        if (frame->mode == Mode::Detect) {
+            stats_.inferenceMs = frame->inferenceMs;
+        }
+        if (replaced) {
+            stats_.displayDropped++;
+        }
+    }
+    publishStats(*frame);
+}
+
+void CameraPipeline::updateTracker(Frame& frame) {
+    ClassFilterManager& classFilter = ClassFilterManager::getInstance();
+    size_t originalCount = frame.detections.size();
+
+    // Class filter, region filter and ByteTrack, as in offline processing
+    frame.tracks = regionTracker_.track(frame.detections, classFilter.getSelectedClasses(), *frame.regions);
+
+    // Debug logging (only log when filtering actually happens)
+    if (!classFilter.isCountAllMode() && originalCount > 0) {
+        if (filterLogCounter_++ % 100 == 0) {  // Log every 100 frames to avoid spam
+            std::cout << "ClassFilter: " << originalCount << " detections → "
+                     << frame.detections.size() << " after class and region filtering" << std::endl;
+        }
+    }
+
+    // Velocities for the tracker-only frames that follow
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        scheduler_.updateTracks(frame.tracks);
+    }
+    activeTrackCount_.store(frame.tracks.size(), std::memory_order_relaxed);
+}
+
+void CameraPipeline::updateRegions(Frame& frame) {
+    int captureInterval = EventManager::getInstance().getPeriodicCaptureInterval();
+    RegionTracker::RegionUpdate update =
+        regionTracker_.updateRegions(frame.tracks, *frame.regions, frame.number, captureInterval);
+
+    frame.trackClasses.clear();
+    for (const auto& track : frame.tracks) {
+        frame.trackClasses.push_back(trackClassName(frame, track.trackId));
+    }
+    frame.trackRegions = std::move(update.trackRegions);
+    frame.regionCounts = std::move(update.regionCounts);
+
+    if (update.regionEntered) {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        scheduler_.reportRegionEntry();
+    }
+
+    for (const RegionTracker::Event& event : update.events) {
+        captureEvent(frame, event, trackClassName(frame, event.trackId));
+
+        if (event.type != EventType::FIRST_ENTRY) {
+            continue;
+        }
+
+        // Record unique object entry for region counting
+        bool isNewUniqueId = RegionCountManager::getInstance().recordObjectEntry(
+            event.regionName, event.trackId, cameraName_
+        );
+
+        // Optional: Log when a new unique object is counted
+        if (isNewUniqueId) {
+            std::cout << "[RegionCount] New object ID " << event.trackId
+                      << " entered region '" << event.regionName
+                      << "' (Camera: " << cameraName_ << ")"
+                      << " - Total unique count: "
+                      << RegionCountManager::getInstance().getRegionCount(event.regionName)
+                      << std::endl;
+        }
+    }
+}
+
+std::string CameraPipeline::trackClassName(const Frame& frame, size_t trackId) const {
+    int classId = regionTracker_.getTrackClass(trackId);
+    return classId >= 0 ? frame.inference->getClassName(classId) : "unknown";
+}
+
+void CameraPipeline::annotate(Frame& frame) {
+    cv::Mat& image = frame.captured.image;
+
+    // Draw regions overlay first
+    drawRegions(image, frame);
+
+    // Draw tracked objects on frame
+    for (size_t i = 0; i < frame.tracks.size(); ++i) {
+        const TrackedBox& track = frame.tracks[i];
+        const cv::Rect& box = track.box;
+
+        // Get consistent color for this track ID
+        cv::Scalar color = getColorForTrackID(track.trackId);
+
+        // Draw bounding box
+        cv::rectangle(image, box, color, 2);
+
+        // Draw text with track ID and region name
+        std::string label = "[ID:" + std::to_string(track.trackId) + "] " +
+                           frame.trackClasses[i] + " " +
+                           std::to_string(track.score).substr(0, 4);
+
+        if (!frame.trackRegions[i].empty()) {
+            label += " [" + frame.trackRegions[i] + "]";
+        }
+
+        cv::Size textSize = cv::getTextSize(label, cv::FONT_HERSHEY_DUPLEX, 0.6, 2, 0);
+        cv::Rect textBox(box.x, box.y - 30, textSize.width + 10, textSize.height + 15);
+
+        cv::rectangle(image, textBox, color, cv::FILLED);
+        cv::putText(image, label, cv::Point(box.x + 5, box.y - 8),
+                   cv::FONT_HERSHEY_DUPLEX, 0.6, cv::Scalar(255, 255, 255), 2, 0);
+    }
+
+    // Draw camera name overlay (top-left corner)
+    cv::Size nameSize = cv::getTextSize(cameraName_, cv::FONT_HERSHEY_DUPLEX, 0.8, 2, 0);
+    cv::Rect nameBox(5, 5, nameSize.width + 15, nameSize.height + 15);
+    cv::rectangle(image, nameBox, cv::Scalar(0, 0, 0), cv::FILLED);
+    cv::putText(image, cameraName_, cv::Point(12, 25),
+               cv::FONT_HERSHEY_DUPLEX, 0.8, cv::Scalar(255, 255, 255), 2, cv::LINE_AA);
+
+    // Draw tracking info overlay (bottom-left corner)
+    std::string infoText = "Tracks: " + std::to_string(frame.tracks.size()) +
+                          " | Detections: " + std::to_string(frame.detections.size()) +
+                          " | Regions: " + std::to_string(frame.regions->size());
+
+    {
+        std::lock_guard<std::mutex> lock(schedulerMutex_);
+        if (scheduler_.getConfig().enabled) {
+            infoText += " | Detect 1/" + std::to_string(scheduler_.getInterval());
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(motionGateMutex_);
+        if (motionGate_.getConfig().enabled) {
+            infoText += " | Inferred " + std::to_string(motionGate_.getInferredFrames()) +
+                        " / Skipped " + std::to_string(motionGate_.getSkippedFrames());
+        }
+    }
+
+    // Frames the capture thread replaced before the pipeline could take them
+    if (uint64_t dropped = camera_->getDroppedFrames()) {
+        infoText += " | Dropped " + std::to_string(dropped);
+    }
+
+    if (uint64_t outages = camera_->getOutageCount()) {
+        infoText += " | Outages " + std::to_string(outages) +
+                    " (last " + std::to_string(camera_->getLastOutageMs() / 1000) + " s)";
+    }
+
+    // Add class filter info
+    if (!ClassFilterManager::getInstance().isCountAllMode()) {
+        int selectedCount = ClassFilterManager::getInstance().getSelectedClassCount();
+        infoText += " | Filter: " + std::to_string(selectedCount) + " classes";
+    } else {
+        infoText += " | Filter: ALL";
+    }
+
+    std::string fullInfoText = "Running | " + infoText;
+
+    cv::Size infoSize = cv::getTextSize(fullInfoText, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, 0);
+    int infoY = image.rows - 10;
+    cv::Rect infoBox(5, infoY - infoSize.height - 10, infoSize.width + 15, infoSize.height + 15);
+    cv::rectangle(image, infoBox, cv::Scalar(0, 0, 0), cv::FILLED);
+
+    // Use different color for filtered mode
+    cv::Scalar infoColor = ClassFilterManager::getInstance().isCountAllMode() ?
+                          cv::Scalar(0, 255, 0) : cv::Scalar(0, 165, 255);  // Green for all, Orange for filtered
+
+    cv::putText(image, fullInfoText, cv::Point(12, infoY - 5),
+               cv::FONT_HERSHEY_SIMPLEX, 0.5, infoColor, 1, cv::LINE_AA);
+}
+
+void CameraPipeline::drawRegions(cv::Mat& image, const Frame& frame) {
+    // Draw each region
+    for (const auto& region : *frame.regions) {
+        const auto& points = region.getPoints();
+        if (points.size() < 3) {
+            continue;  // Skip invalid regions
+        }
+
+        // Draw filled polygon with transparency
+        cv::Mat overlay = camera_->getFramePool()->clone(image);
+        std::vector<std::vector<cv::Point>> polygons = {points};
+        cv::fillPoly(overlay, polygons, region.getColor());
+        cv::addWeighted(overlay, 0.3, image, 0.7, 0, image);
+
+        // Draw polygon border
+        cv::polylines(image, polygons, true, region.getColor(), 2, cv::LINE_AA);
+
+        // Draw unique object count at centroid (instead of region name)
+        cv::Point centroid(0, 0);
+        for (const auto& pt : points) {
+            centroid.x += pt.x;
+            centroid.y += pt.y;
+        }
+        centroid.x /= points.size();
+        centroid.y /= points.size();
+
+        auto it = frame.regionCounts.find(region.getName());
+        int uniqueCount = it != frame.regionCounts.end() ? it->second : 0;
+
+        // Display count instead of name
+        std::string regionLabel = std::to_string(uniqueCount);
+        int fontFace = cv::FONT_HERSHEY_DUPLEX;
+        double fontScale = 1.2;
+        int thickness = 2;
+
+        cv::Size textSize = cv::getTextSize(regionLabel, fontFace, fontScale, thickness, 0);
+        cv::Point textOrg(centroid.x - textSize.width / 2, centroid.y + textSize.height / 2);
+
+        // Draw text background (larger for better visibility)
+        cv::Rect textRect(textOrg.x - 10, textOrg.y - textSize.height - 10,
+                         textSize.width + 20, textSize.height + 20);
+        cv::rectangle(image, textRect, region.getColor(), cv::FILLED);
+
+        // Draw border around count
+        cv::rectangle(image, textRect, cv::Scalar(255, 255, 255), 2);
+
+        // Draw count text
+        cv::putText(image, regionLabel, textOrg, fontFace, fontScale,
+                   cv::Scalar(255, 255, 255), thickness, cv::LINE_AA);
+    }
+}
+
+void CameraPipeline::emitCrops(const std::shared_ptr<Frame>& frame) {
+    const cv::Mat& image = frame->captured.image;
+
+    // Throttled per track to avoid flooding the panel
+    std::vector<size_t> crops;
+    for (size_t i = 0; i < frame->tracks.size(); ++i) {
+        const TrackedBox& track = frame->tracks[i];
+        int& lastEmit = lastCropEmitFrame_[track.trackId];
+        if (lastEmit != 0 && frame->number - lastEmit < kCropEmitInterval) {
+            continue;
+        }
+
+        cv::Rect safeBox = track.box & cv::Rect(0, 0, image.cols, image.rows);
+        if (safeBox.width > 0 && safeBox.height > 0) {
+            crops.push_back(i);
+            lastEmit = frame->number;
+        }
+    }
+    if (crops.empty()) {
+        return;
+    }
+
+    // Colour conversion of the crops runs beside the camera's next frame; the image is read-only by now
+    {
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        cropTasks_++;
+    }
+    TaskScheduler::getInstance().submit([this, frame, crops]() {
+        ScopeGuard cropSlot([this]() {
+            std::lock_guard<std::mutex> lock(flowMutex_);
+            cropTasks_--;
+            flowIdle_.notify_all();
+        });
+
+        const cv::Mat& annotated = frame->captured.image;
+        QImage fullFrameImage = cvMatToQImage(annotated);
+
+        for (size_t i : crops) {
+            const TrackedBox& track = frame->tracks[i];
+            cv::Rect safeBox = track.box & cv::Rect(0, 0, annotated.cols, annotated.rows);
+
+            // cvMatToQImage converts into its own buffer, so the ROI view needs no copy
+            emit cropDetected(cvMatToQImage(annotated(safeBox)), fullFrameImage,
+                              QString::fromStdString(frame->trackClasses[i]),
+                              static_cast<int>(track.trackId), track.score);
+        }
+    });
+}
+
+void CameraPipeline::publishStats(const Frame& frame) {
+    statsWindowFrames_++;
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - statsWindowStart_).count();
+    if (elapsed < 1.0) {
+        return;
+    }
+
+    PipelineStats stats;
+    {
+        std::lock_guard<std::mutex> lock(motionGateMutex_);
+        stats.inferredFrames = motionGate_.getInferredFrames();
+        stats.skippedFrames = motionGate_.getSkippedFrames();
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.fps = statsWindowFrames_ / elapsed;
+        stats_.framesDropped = camera_->getDroppedFrames();
+        stats_.inferredFrames = stats.inferredFrames;
+        stats_.skippedFrames = stats.skippedFrames;
+        stats = stats_;
+    }
+
+    statsWindowStart_ = now;
+    statsWindowFrames_ = 0;
+    emit statsUpdated(stats);
+}
+
+void CameraPipeline::captureEvent(const Frame& frame, const RegionTracker::Event& trackEvent,
+                                  const std::string& className) {
+    size_t trackId = trackEvent.trackId;
+    const std::string& regionName = trackEvent.regionName;
+    const cv::Rect& bbox = trackEvent.box;
+    EventType eventType = trackEvent.type;
+    float confidence = trackEvent.score;
+
+    // Crop object from the frame (or the matching main-stream frame) before anything is drawn on it
+    cv::Rect box;
+    double scale = 1.0;
+    cv::Mat image = eventFrame(frame, bbox, box, scale);
+
+    cv::Mat croppedImage;
+    if (!image.empty() && box.area() > 0 && box.x >= 0 && box.y >= 0 &&
+        box.x + box.width <= image.cols &&
+        box.y + box.height <= image.rows) {
+
+        // Add some padding around the object
+        int padding = cvRound(15 * scale);
+        int x = std::max(0, box.x - padding);
+        int y = std::max(0, box.y - padding);
+        int w = std::min(image.cols - x, box.width + 2 * padding);
+        int h = std::min(image.rows - y, box.height + 2 * padding);
+
+        cv::Rect paddedBox(x, y, w, h);
+        croppedImage = image(paddedBox);  // Written to disk before the annotate stage draws on the frame
+    }
+
+    if (croppedImage.empty()) {
+        return;  // Failed to crop, skip event
+    }
+
+    // Save image to disk
+    EventManager& manager = EventManager::getInstance();
+    std::string imagePath = manager.saveEventImage(
+        croppedImage,
+        cameraName_,
+        regionName,
+        trackId,
+        eventType
+    );
+
+    if (imagePath.empty()) {
+        return;  // Failed to save, skip event
+    }
+
+    // Create and add event
+    DetectionEvent event(
+        trackId,
+        camera_->getId(),
+        cameraName_,
+        regionName,
+        className,
+        confidence,
+        eventType,
+        bbox,
+        imagePath
+    );
+
+    event.setFrameNumber(frame.number);
+    manager.addEvent(event);
+
+    // Send to Telegram if enabled and event is FIRST_ENTRY or EXIT
+    if (TelegramBot::getInstance().isEnabled() &&
+        (eventType == EventType::FIRST_ENTRY || eventType == EventType::EXIT)) {
+
+        // Check throttling - only send if 5 seconds passed since last send for this region
+        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+        auto it = lastTelegramSendTime_.find(regionName);
+
+        bool canSend = (it == lastTelegramSendTime_.end() ||
+                        (currentTime - it->second) >= TELEGRAM_THROTTLE_MS);
+
+        if (canSend) {
+            // Get region count
+            int regionCount = RegionCountManager::getInstance().getRegionCount(regionName);
+
+            // Build caption
+            QString eventTypeStr = (eventType == EventType::FIRST_ENTRY) ? "ENTRY" : "EXIT";
+            QString caption = QString("[%1] Camera: %2 | Region: %3 | Count: %4")
+                .arg(eventTypeStr)
+                .arg(QString::fromStdString(cameraName_))
+                .arg(QString::fromStdString(regionName))
+                .arg(regionCount);
+
+            // Draw bounding box on full frame
+            // Main-stream frames are a different size; keep them out of the display pool
+            cv::Mat fullFrameWithBox = image.data == frame.captured.image.data ?
+                camera_->getFramePool()->clone(image) : image.clone();
+            int thickness = std::max(2, cvRound(2 * scale));
+            cv::rectangle(fullFrameWithBox, box, cv::Scalar(0, 255, 0), thickness);
+
+            // Add label above bounding box
+            std::string label = className + " ID:" + std::to_string(trackId);
+            double fontScale = 0.5 * scale;
+            int margin = cvRound(5 * scale);
+            int baseline;
+            cv::Size textSize = cv::getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, fontScale, thickness, &baseline);
+            cv::rectangle(fullFrameWithBox,
+                         cv::Point(box.x, box.y - textSize.height - margin),
+                         cv::Point(box.x + textSize.width, box.y),
+                         cv::Scalar(0, 255, 0), -1);
+            cv::putText(fullFrameWithBox, label,
+                       cv::Point(box.x, box.y - margin),
+                       cv::FONT_HERSHEY_SIMPLEX, fontScale,
+                       cv::Scalar(0, 0, 0), thickness);
+
+            // QPixmap and the bot's network manager belong to the GUI thread
+            QImage photo = cvMatToQImage(fullFrameWithBox);
+            QMetaObject::invokeMethod(&TelegramBot::getInstance(), [photo, caption]() {
+                TelegramBot::getInstance().sendPhoto(QPixmap::fromImage(photo), caption);
+            }, Qt::QueuedConnection);
+
+            // Update throttle time
+            lastTelegramSendTime_[regionName] = currentTime;
+
+            std::cout << "📤 Telegram: Sent " << eventTypeStr.toStdString()
+                      << " event for region '" << regionName << "'" << std::endl;
+        } else {
+            // Throttled
+            qint64 timeSinceLastSend = currentTime - it->second;
+            qint64 timeRemaining = TELEGRAM_THROTTLE_MS - timeSinceLastSend;
+            std::cout << "⏱️  Telegram: Throttled for region '" << regionName
+                      << "' (wait " << (timeRemaining / 1000) << "s)" << std::endl;
+        }
+    }
+}
+
+void CameraPipeline::refreshMainFrame(const Frame& frame) {
+    if (!camera_->hasSubstream()) {
+        return;
+    }
+
+    // Pick up the frame asked for last time, and ask for the next one while something could
+    // raise an event. Converting happens on the capture thread; this worker never waits for it.
+    camera_->takeMainFrame(mainFrame_);
+    if (!frame.tracks.empty() && !frame.regions->empty()) {
+        camera_->requestMainFrame();
+    }
+}
+
+cv::Mat CameraPipeline::eventFrame(const Frame& frame, const cv::Rect& bbox, cv::Rect& eventBox, double& scale) {
+    const cv::Mat& image = frame.captured.image;
+    eventBox = bbox;
+    scale = 1.0;
+    if (!camera_->hasSubstream() || image.empty() || mainFrame_.image.empty()) {
+        return image;
+    }
+
+    auto skew = std::chrono::duration_cast<std::chrono::milliseconds>(
+        mainFrame_.timestamp - frame.captured.timestamp).count();
+    if (std::abs(skew) > kMainFrameMaxSkewMs) {
+        return image;  // Main stream stalled or just asked for; the substream crop is better than a stale one
+    }
+
+    double scaleX = static_cast<double>(mainFrame_.image.cols) / image.cols;
+    double scaleY = static_cast<double>(mainFrame_.image.rows) / image.rows;
+    eventBox = cv::Rect(cvRound(bbox.x * scaleX), cvRound(bbox.y * scaleY),
+                        cvRound(bbox.width * scaleX), cvRound(bbox.height * scaleY)) &
+               cv::Rect(0, 0, mainFrame_.image.cols, mainFrame_.image.rows);
+    scale = std::min(scaleX, scaleY);
+    return mainFrame_.image;
+}
+
+cv::Rect CameraPipeline::inferenceRoi(const cv::Size& frameSize, const std::vector<Region>& regions,
+                                      bool enabled, float marginRatio) {
+    cv::Rect fullFrame(0, 0, frameSize.width, frameSize.height);
+    if (!enabled || regions.empty()) {
+        return fullFrame;
+    }
+
+    // Detections outside the regions are discarded anyway, so only the area around them is detected
+    cv::Rect roi = Region::getCombinedRoi(regions, frameSize, marginRatio);
+    return roi.empty() ? fullFrame : roi;
+}
+
+void CameraPipeline::offsetDetections(std::vector<Detection>& detections, const cv::Point& offset) {
+    if (offset.x == 0 && offset.y == 0) {
+        return;
+    }
+    for (auto& det : detections) {
+        det.box.x += offset.x;
+        det.box.y += offset.y;
+    }
+}
+
+QImage CameraPipeline::cvMatToQImage(const cv::Mat& mat) {
+    if (mat.empty()) {
+        return QImage();
+    }
+
+    cv::Mat rgb = camera_->getFramePool()->borrow();
+    if (mat.channels() == 1) {
+        cv::cvtColor(mat, rgb, cv::COLOR_GRAY2RGB);
+    } else if (mat.channels() == 3) {
+        cv::cvtColor(mat, rgb, cv::COLOR_BGR2RGB);
+    } else {
+        mat.copyTo(rgb);
+    }
+
+    // The QImage shares the pooled buffer and returns it to the pool when Qt releases the image
+    cv::Mat* owner = new cv::Mat(rgb);
+    return QImage(owner->data, owner->cols, owner->rows, owner->step, QImage::Format_RGB888,
+                  [](void* info) { delete static_cast<cv::Mat*>(info); }, owner);
+}
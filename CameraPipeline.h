@@ -0,0 +1,276 @@
+#ifndef CAMERAPIPELINE_H
+#define CAMERAPIPELINE_H
+
+#include <QObject>
+#include <QImage>
+#include <QMetaType>
+#include <QString>
+#include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "TaskScheduler.h"
+#include "TripleBuffer.h"
+#include "CameraSource.h"
+#include "inference.h"
+#include "BatchInferenceEngine.h"
+#include "DetectionScheduler.h"
+#include "MotionGate.h"
+#include "RegionTracker.h"
+#include "Region.h"
+#include "DetectionEvent.h"
+
+// Counters of a running pipeline, sent to the GUI about once per second
+struct PipelineStats {
+    double fps = 0.0;              // Frames leaving the pipeline
+    double inferenceMs = 0.0;      // Detector latency of the last detected frame
+    uint64_t framesProcessed = 0;
+    uint64_t framesDropped = 0;    // Replaced in the capture buffer before the pipeline took them
+    uint64_t displayDropped = 0;   // Replaced in the display buffer before the GUI took them
+    uint64_t inferredFrames = 0;   // Motion gate counters
+    uint64_t skippedFrames = 0;
+    size_t trackCount = 0;
+};
+
+Q_DECLARE_METATYPE(PipelineStats)
+Q_DECLARE_METATYPE(FrameGrabber::ConnectionState)
+
+/**
+ * @brief Per-camera processing worker, independent of any widget
+ *
+ * A frame goes through five stages:
+ *
+ *   capture -> preprocess -> infer -> track -> annotate
+ *
+ * capture     the camera's FrameGrabber thread decodes and signals a new frame
+ * preprocess  detection schedule, motion gate and ROI for the frame
+ * infer       detector run on a BatchInferenceEngine thread
+ * track       class/region filter, ByteTrack, region counts and events
+ * annotate    regions, tracks and overlays; FrameBus; QImage for display
+ *
+ * Apart from capture, the stages own no threads: they are tasks on the
+ * shared TaskScheduler. Preprocess runs on one strand, track and annotate
+ * on a second, so each camera's motion gate, tracker and events see frames
+ * in order while different cameras run on any free worker. Detection runs
+ * on the engine's own threads and completes through a callback, so no
+ * worker holds a forward pass.
+ *
+ * One frame at a time is between the two strands, and at most two wait on
+ * the second; when the pipeline is full, the grabber's newest-frame-wins
+ * buffer drops frames instead of letting latency build up. Finished frames
+ * go to the GUI through a lock-free triple buffer: the widget takes the
+ * newest one when it gets to it, and frames it did not get to are dropped.
+ * Only a payload-free notification (at most one outstanding) and the stats
+ * go through the event loop. Without a connected widget the pipeline keeps
+ * counting, saving events and feeding full-screen views.
+ *
+ * Settings may be changed from the GUI thread while running; a frame uses
+ * the inference, regions and ROI settings in effect when it was
+ * preprocessed.
+ */
+class CameraPipeline : public QObject {
+    Q_OBJECT
+
+public:
+    CameraPipeline(std::shared_ptr<CameraSource> camera,
+                   std::shared_ptr<Inference> inference,
+                   QObject* parent = nullptr);
+    ~CameraPipeline();
+
+    // Open the camera if needed and start pulling frames through the scheduler; false if the camera cannot be opened
+    bool start();
+
+    // Stop taking new frames, wait for the frames in flight to finish, then close the camera
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    int getCameraId() const { return camera_->getId(); }
+    std::shared_ptr<CameraSource> getCamera() const { return camera_; }
+
+    void setInference(std::shared_ptr<Inference> inference);
+
+    // Route detection through the shared detection service (nullptr = a private unbatched engine
+    // on this camera's inference, created when the pipeline starts)
+    void setBatchInferenceEngine(std::shared_ptr<BatchInferenceEngine> engine);
+
+    // Run the detector every K frames and extrapolate tracks in between
+    void setDetectionSchedule(const DetectionScheduler::Config& config);
+
+    // Skip the detector on frames without motion (forced detection every N frames)
+    void setMotionGate(const MotionGate::Config& config);
+
+    // Detect only on the union of the regions (plus margin) instead of the full frame
+    void setRoiInference(bool enabled, float marginRatio);
+
+    void setRegions(const std::vector<Region>& regions);
+
+    PipelineStats getStats() const;
+
+    /**
+     * @brief Take the newest annotated frame for display (RGB888); never blocks
+     * @return false if no frame finished since the last call
+     *
+     * Single consumer: the camera's widget, on the GUI thread.
+     */
+    bool takeDisplayFrame(QImage& image);
+
+signals:
+    // A display frame is waiting; not emitted again until takeDisplayFrame() was called
+    void displayFrameAvailable();
+    void statsUpdated(const PipelineStats& stats);
+    void connectionStateChanged(FrameGrabber::ConnectionState state);
+
+    // The source ended (end of file, no reconnect policy); the pipeline stops itself
+    void sourceFailed();
+
+    // Throttled per-track crop for the realtime panel, with the annotated frame
+    void cropDetected(const QImage& cropImage, const QImage& fullFrameImage,
+                      const QString& className, int trackId, float confidence);
+
+private:
+    // What the detector does for a frame
+    enum class Mode {
+        Detect,   // Run the detector
+        Static,   // Motion gate: no change, tracker gets an empty update
+        Predict   // Detection schedule: extrapolate the tracks
+    };
+
+    // One frame on its way through the stages
+    struct Frame {
+        CapturedFrame captured;
+        int number = 0;
+        bool afterOutage = false;
+        Mode mode = Mode::Detect;
+        cv::Rect roi;
+
+        // Settings snapshot taken by the preprocess stage
+        std::shared_ptr<Inference> inference;
+        std::shared_ptr<BatchInferenceEngine> batchEngine;
+        std::shared_ptr<const std::vector<Region>> regions;
+
+        std::vector<Detection> detections;
+        double inferenceMs = 0.0;
+
+        // Track stage output, parallel to tracks
+        std::vector<TrackedBox> tracks;
+        std::vector<std::string> trackClasses;
+        std::vector<std::string> trackRegions;
+        std::map<std::string, int> regionCounts;
+    };
+
+    // Start the next frame if one is waiting and the pipeline has room; call with flowMutex_ held
+    void pumpLocked(std::unique_lock<std::mutex>& lock);
+    void pump();
+
+    // Free the front after a frame was dropped or failed before reaching the back strand
+    void releaseFront();
+
+    // Stage tasks
+    void preprocessNext();
+    void infer(const std::shared_ptr<Frame>& frame);
+    void finishInference(Frame& frame, std::chrono::steady_clock::time_point start);
+    void handOff(const std::shared_ptr<Frame>& frame);
+    void trackAndAnnotate(const std::shared_ptr<Frame>& frame);
+
+    // GUI thread: connection state and end of source, which no frame reports
+    void checkConnection();
+
+    void updateTracker(Frame& frame);
+    void updateRegions(Frame& frame);
+    std::string trackClassName(const Frame& frame, size_t trackId) const;
+    void annotate(Frame& frame);
+    void drawRegions(cv::Mat& image, const Frame& frame);
+    void emitCrops(const std::shared_ptr<Frame>& frame);
+    void publishStats(const Frame& frame);
+
+    void captureEvent(const Frame& frame, const RegionTracker::Event& trackEvent, const std::string& className);
+
+    // Dual-stream cameras: take the main-stream frame that arrived since the last frame and request the next
+    void refreshMainFrame(const Frame& frame);
+
+    // Image to crop events from, with bbox mapped into it (the main stream when the camera has a substream)
+    cv::Mat eventFrame(const Frame& frame, const cv::Rect& bbox, cv::Rect& eventBox, double& scale);
+
+    // Regions mapped to the size of the frames detected on; warns about old regions that do not fit
+    std::shared_ptr<const std::vector<Region>> fitRegions(const std::vector<Region>& regions,
+                                                          const cv::Size& frameSize) const;
+
+    static cv::Rect inferenceRoi(const cv::Size& frameSize, const std::vector<Region>& regions,
+                                 bool enabled, float marginRatio);
+    static void offsetDetections(std::vector<Detection>& detections, const cv::Point& offset);
+    QImage cvMatToQImage(const cv::Mat& mat);
+
+    std::shared_ptr<CameraSource> camera_;
+    std::string cameraName_;
+
+    std::atomic<bool> running_{false};
+
+    // Frame flow between the stage tasks; stop() waits here until no task is left
+    std::shared_ptr<TaskScheduler::Strand> frontStrand_;  // preprocess
+    std::shared_ptr<TaskScheduler::Strand> backStrand_;   // track, annotate
+    std::mutex flowMutex_;
+    std::condition_variable flowIdle_;
+    bool accepting_ = false;
+    bool frontBusy_ = false;  // A frame is being preprocessed or detected
+    int backlog_ = 0;         // Frames posted to the back strand and not finished
+    int cropTasks_ = 0;
+
+    // Settings written by the GUI thread, snapshotted per frame by the preprocess stage
+    mutable std::mutex settingsMutex_;
+    std::shared_ptr<Inference> inference_;
+    std::shared_ptr<BatchInferenceEngine> batchEngine_;
+    bool ownsEngine_ = false;  // batchEngine_ is this camera's private engine on inference_
+    std::shared_ptr<const std::vector<Region>> drawnRegions_;  // As set, in the coordinates they were drawn in
+    std::shared_ptr<const std::vector<Region>> regions_;       // drawnRegions_ mapped to regionsFrameSize_
+    cv::Size regionsFrameSize_;
+    bool roiInferenceEnabled_ = false;
+    float roiMarginRatio_ = 0.15f;
+    std::atomic<bool> inferenceChanged_{false};
+
+    // The detection schedule is shared by the preprocess, infer and track stages
+    mutable std::mutex schedulerMutex_;
+    DetectionScheduler scheduler_;
+
+    // Preprocess stage; locked for configuration and counters from other threads
+    mutable std::mutex motionGateMutex_;
+    MotionGate motionGate_;
+    std::atomic<size_t> activeTrackCount_{0};
+
+    // Connection state, polled on the GUI thread
+    QTimer* connectionTimer_;
+    FrameGrabber::ConnectionState connectionState_ = FrameGrabber::ConnectionState::Disconnected;
+    std::atomic<bool> outagePending_{false};
+
+    // Preprocess stage
+    int frameNumber_ = 0;
+
+    // Track stage
+    RegionTracker regionTracker_;
+    int filterLogCounter_ = 0;  // Throttles the class filter debug log
+
+    // Telegram throttling (region name -> last send timestamp in ms)
+    std::map<std::string, qint64> lastTelegramSendTime_;
+    static constexpr int TELEGRAM_THROTTLE_MS = 5000;  // 5 seconds
+
+    // Dual-stream cameras: newest main-stream frame, requested one processed frame ahead of the events
+    CapturedFrame mainFrame_;
+
+    // Track/annotate stage
+    std::map<size_t, int> lastCropEmitFrame_;
+    TripleBuffer<QImage> display_;
+    std::atomic<bool> displayNotified_{false};  // displayFrameAvailable() sent and not yet answered
+    std::chrono::steady_clock::time_point statsWindowStart_;
+    uint64_t statsWindowFrames_ = 0;
+
+    mutable std::mutex statsMutex_;
+    PipelineStats stats_;
+};
+
+#endif // CAMERAPIPELINE_H
@@ -1,12 +1,11 @@
 #include "CameraSource.h"
 #include <iostream>
-#include <thread>
-#include <chrono>
 
 using json = nlohmann::json;
 
 CameraSource::CameraSource(int id, const std::string& name, CameraType type, const std::string& source)
-    : id_(id), name_(name), type_(type), source_(source), isActive_(false) {
+    : id_(id), name_(name), type_(type), source_(source), isActive_(false),
+      framePool_(std::make_shared<FramePool>(name)) {
 }
 
 CameraSource::~CameraSource() {
@@ -24,57 +23,124 @@ void CameraSource::setSource(const std::string& source) {
     }
 }
 
+void CameraSource::setSubstream(const std::string& substream) {
+    bool wasOpened = isOpened();
+    if (wasOpened) {
+        close();
+    }
+    substream_ = substream;
+    if (wasOpened) {
+        open();
+    }
+}
+
 bool CameraSource::open() {
     if (isOpened()) {
         return true;
     }
 
-    try {
-        if (type_ == CameraType::WEBCAM) {
-            int deviceId = std::stoi(source_);
-            capture_.open(deviceId);
-        } else {
-            capture_.open(source_);
-        }
+    FrameGrabber::CaptureSpec spec;
+    spec.source = hasSubstream() ? substream_ : source_;
+    spec.isDevice = type_ == CameraType::WEBCAM;
+    spec.paceToSourceFps = type_ == CameraType::VIDEO_FILE;
+    if (type_ == CameraType::RTSP_STREAM || type_ == CameraType::IP_CAMERA) {
+        spec.timeoutMs = 5000;  // Bounds how long a dead stream can block the capture thread
+        spec.reconnect.enabled = true;
+    }
 
-        if (capture_.isOpened()) {
-            isActive_ = true;
-            std::cout << "Camera '" << name_ << "' opened successfully." << std::endl;
-            return true;
+    SourceRegistry& registry = SourceRegistry::getInstance();
+    grabber_ = registry.acquire(spec, name_);
+    if (!grabber_) {
+        isActive_ = false;
+        return false;
+    }
+    subscriber_ = grabber_->subscribe();
+    isActive_ = true;
+    std::cout << "Camera '" << name_ << "' opened successfully." << std::endl;
+
+    if (hasSubstream()) {
+        FrameGrabber::CaptureSpec mainSpec = spec;
+        mainSpec.source = source_;
+        mainSpec.paceToSourceFps = false;
+        mainSpec.decodeOnDemand = true;
+        mainGrabber_ = registry.acquire(mainSpec, name_ + " (main)");
+        if (mainGrabber_) {
+            mainSubscriber_ = mainGrabber_->subscribe();
+            std::cout << "   Detecting on substream, event crops from main stream" << std::endl;
+        } else {
+            std::cerr << "⚠️  Camera '" << name_ << "': main stream unavailable, event crops use the substream" << std::endl;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Error opening camera '" << name_ << "': " << e.what() << std::endl;
     }
-
-    isActive_ = false;
-    return false;
+    return true;
 }
 
 void CameraSource::close() {
-    if (capture_.isOpened()) {
-        capture_.release();
+    // The capture threads stop once no other camera uses the same source
+    if (mainGrabber_) {
+        mainGrabber_->unsubscribe(mainSubscriber_);
+        mainSubscriber_.reset();
+        mainGrabber_.reset();
+    }
+    if (grabber_) {
         isActive_ = false;
-        std::cout << "Camera '" << name_ << "' closed." << std::endl;
+        std::cout << "Camera '" << name_ << "' closed (" << grabber_->getCapturedFrames() << " frames captured, "
+                  << subscriber_->getDroppedFrames() << " dropped, " << grabber_->getOutageCount() << " outage(s) totalling "
+                  << grabber_->getTotalOutageMs() << " ms)." << std::endl;
+
+        FramePool::Stats capturePool = grabber_->getPoolStats();
+        std::cout << "   Capture pool (per source): high-water " << capturePool.highWaterMark << " buffer(s), "
+                  << capturePool.allocations << " allocation(s), " << capturePool.reuses << " reuse(s)" << std::endl;
+        FramePool::Stats pool = framePool_->getStats();
+        std::cout << "   Frame pool: high-water " << pool.highWaterMark << " buffer(s), "
+                  << pool.allocations << " allocation(s), " << pool.reuses << " reuse(s)" << std::endl;
+
+        subscriber_->setListener(nullptr);
+        grabber_->unsubscribe(subscriber_);
+        subscriber_.reset();
+        grabber_.reset();
+    }
+}
+
+void CameraSource::setFrameListener(std::function<void()> listener) {
+    if (subscriber_) {
+        subscriber_->setListener(std::move(listener));
     }
 }
 
-bool CameraSource::read(cv::Mat& frame) {
-    if (!isOpened()) {
+bool CameraSource::grabLatest(CapturedFrame& frame) {
+    if (!grabber_) {
         return false;
     }
 
-    bool success = capture_.read(frame);
-    if (!success) {
-        std::cerr << "Failed to read frame from camera '" << name_ << "'" << std::endl;
+    // A frame published just before the thread failed is still delivered
+    if (subscriber_->takeLatest(frame)) {
+        // Other cameras on this source hold the same buffer; this one draws overlays into its copy
+        if (frame.image.u && frame.image.u->refcount > 1) {
+            frame.image = framePool_->clone(frame.image);
+        }
+        return true;
+    }
+    if (grabber_->hasFailed()) {
         isActive_ = false;
     }
-    return success;
+    return false;
+}
+
+void CameraSource::requestMainFrame() {
+    if (mainGrabber_) {
+        mainGrabber_->requestFrame();
+    }
+}
+
+bool CameraSource::takeMainFrame(CapturedFrame& frame) {
+    return mainSubscriber_ && mainSubscriber_->takeLatest(frame);
 }
 
 void CameraSource::reconnect() {
+    // Streams retry on their own capture thread; this forces a fresh start without waiting
+    // (unless another camera keeps the shared capture thread alive)
     std::cout << "Attempting to reconnect camera '" << name_ << "'..." << std::endl;
     close();
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
     open();
 }
 
@@ -93,21 +159,29 @@ int CameraSource::getOpenCVCaptureParam() const {
 }
 
 json CameraSource::toJson() const {
-    return json{
+    json j{
         {"id", id_},
         {"name", name_},
         {"type", cameraTypeToString(type_)},
         {"source", source_}
     };
+    if (hasSubstream()) {
+        j["substream"] = substream_;
+    }
+    return j;
 }
 
 CameraSource CameraSource::fromJson(const json& j) {
-    return CameraSource(
+    CameraSource camera(
         j.at("id").get<int>(),
         j.at("name").get<std::string>(),
         stringToCameraType(j.at("type").get<std::string>()),
         j.at("source").get<std::string>()
     );
+    if (j.contains("substream")) {
+        camera.substream_ = j.at("substream").get<std::string>();
+    }
+    return camera;
 }
 
 std::string CameraSource::cameraTypeToString(CameraType type) {
@@ -1,10 +1,14 @@
 #ifndef CAMERASOURCE_H
 #define CAMERASOURCE_H
 
+#include <memory>
 #include <string>
 #include <opencv2/opencv.hpp>
 #include <nlohmann/json.hpp>
 
+#include "FrameGrabber.h"
+#include "SourceRegistry.h"
+
 enum class CameraType {
     WEBCAM,
     VIDEO_FILE,
@@ -22,19 +26,59 @@ public:
     std::string getName() const { return name_; }
     CameraType getType() const { return type_; }
     std::string getSource() const { return source_; }
+    std::string getSubstream() const { return substream_; }
+    bool hasSubstream() const { return !substream_.empty(); }
     bool isActive() const { return isActive_; }
-    bool isOpened() const { return capture_.isOpened(); }
+    bool isOpened() const { return grabber_ && grabber_->isOpened(); }
 
     // Setters
     void setName(const std::string& name) { name_ = name; }
     void setSource(const std::string& source);
 
-    // Camera operations
+    // Low-resolution stream for detection and tracking; the source then only serves event crops
+    void setSubstream(const std::string& substream);
+
+    // Camera operations; open() subscribes to the source's capture thread (shared through
+    // SourceRegistry with every other camera or view of the same source)
     bool open();
     void close();
-    bool read(cv::Mat& frame);
     void reconnect();
 
+    // Take the newest captured frame without waiting; false if none arrived since the last call.
+    // The image is this camera's to draw on: a buffer shared with other subscribers is copied first.
+    bool grabLatest(CapturedFrame& frame);
+
+    // A frame is waiting for grabLatest()
+    bool hasFreshFrame() const { return subscriber_ && subscriber_->hasFreshFrame(); }
+
+    // Called on the capture thread whenever a frame is published (see FrameGrabber::Subscriber::setListener);
+    // only while open, cleared by close()
+    void setFrameListener(std::function<void()> listener);
+
+    // Dual-stream cameras: have the main stream convert its next frame, without waiting for it
+    void requestMainFrame();
+
+    // Newest main-stream frame converted so far (for any camera sharing the main stream); false
+    // without a substream or if none arrived since the last call. Never blocks.
+    bool takeMainFrame(CapturedFrame& frame);
+
+    // The capture thread stopped delivering (end of file, stream lost)
+    bool hasFailed() const { return grabber_ && grabber_->hasFailed(); }
+
+    // Frames decoded but replaced by a newer one before the consumer took them
+    uint64_t getDroppedFrames() const { return subscriber_ ? subscriber_->getDroppedFrames() : 0; }
+
+    // Buffers for processing, display and snapshots of this camera
+    std::shared_ptr<FramePool> getFramePool() const { return framePool_; }
+
+    // Connection health (streams reconnect with backoff on the capture thread)
+    FrameGrabber::ConnectionState getConnectionState() const {
+        return grabber_ ? grabber_->getConnectionState() : FrameGrabber::ConnectionState::Disconnected;
+    }
+    uint64_t getOutageCount() const { return grabber_ ? grabber_->getOutageCount() : 0; }
+    int64_t getLastOutageMs() const { return grabber_ ? grabber_->getLastOutageMs() : 0; }
+    int64_t getTotalOutageMs() const { return grabber_ ? grabber_->getTotalOutageMs() : 0; }
+
     // JSON serialization
     nlohmann::json toJson() const;
     static CameraSource fromJson(const nlohmann::json& j);
@@ -48,8 +92,13 @@ private:
     std::string name_;
     CameraType type_;
     std::string source_;
+    std::string substream_;
     bool isActive_;
-    cv::VideoCapture capture_;
+    std::shared_ptr<FramePool> framePool_;
+    std::shared_ptr<FrameGrabber> grabber_;      // Detection stream: the substream if set, otherwise the source
+    std::shared_ptr<FrameGrabber::Subscriber> subscriber_;
+    std::shared_ptr<FrameGrabber> mainGrabber_;  // Dual-stream only: the source, decoded on demand
+    std::shared_ptr<FrameGrabber::Subscriber> mainSubscriber_;
 
     // Helper to determine OpenCV capture parameter
     int getOpenCVCaptureParam() const;
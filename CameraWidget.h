@@ -6,24 +6,15 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTimer>
 #include <QImage>
 #include <QMenu>
 #include <QContextMenuEvent>
-#include <QDateTime>
 #include <memory>
-#include <map>
 #include <vector>
 
-#include "CameraSource.h"
-#include "inference.h"
-#include "ByteTrack/BYTETracker.h"
+#include "CameraPipeline.h"
 #include "Region.h"
 #include "RegionDrawingWidget.h"
-#include "DetectionEvent.h"
-#include "EventManager.h"
-#include "TelegramBot.h"
-#include "RegionCountManager.h"
 
 class CameraWidget : public QWidget {
     Q_OBJECT
@@ -35,15 +26,32 @@ public:
     ~CameraWidget();
 
     int getCameraId() const { return camera_->getId(); }
-    bool isRunning() const { return isRunning_; }
+    bool isRunning() const { return pipeline_->isRunning(); }
     void updateInference(std::shared_ptr<Inference> inference);
 
+    // Processing runs here, off the GUI thread; the pipeline outlives the widget if someone else holds it
+    std::shared_ptr<CameraPipeline> getPipeline() const { return pipeline_; }
+
+    // Route detection through the shared cross-camera batching service (nullptr = run inline)
+    void setBatchInferenceEngine(std::shared_ptr<BatchInferenceEngine> engine);
+
     // Display settings
     void setDisplaySize(int width, int height);
 
+    // Run the detector every K frames and extrapolate tracks in between
+    void setDetectionSchedule(const DetectionScheduler::Config& config);
+
+    // Skip the detector on frames without motion (forced detection every N frames)
+    void setMotionGate(const MotionGate::Config& config);
+    uint64_t getInferredFrameCount() const { return pipeline_->getStats().inferredFrames; }
+    uint64_t getSkippedFrameCount() const { return pipeline_->getStats().skippedFrames; }
+
+    // Detect only on the union of the regions (plus margin) instead of the full frame
+    void setRoiInference(bool enabled, float marginRatio);
+
     // Region management
     const std::vector<Region>& getRegions() const { return regions_; }
-    void setRegions(const std::vector<Region>& regions) { regions_ = regions; }
+    void setRegions(const std::vector<Region>& regions);
 
 public slots:
     void startCapture();
@@ -61,7 +69,12 @@ protected:
     void contextMenuEvent(QContextMenuEvent* event) override;
 
 private slots:
-    void updateFrame();
+    void onDisplayFrameAvailable();
+    void onStatsUpdated(const PipelineStats& stats);
+    void onConnectionStateChanged(FrameGrabber::ConnectionState state);
+    void onSourceFailed();
+    void onPipelineCrop(const QImage& cropImage, const QImage& fullFrameImage,
+                        const QString& className, int trackId, float confidence);
     void onRemoveClicked();
     void onDrawRegion();
     void onManageRegions();
@@ -69,50 +82,21 @@ private slots:
 
 private:
     void setupUI();
-    void processFrame(cv::Mat& frame);
-    void drawRegionsOnFrame(cv::Mat& frame);
-    cv::Mat drawDetections(cv::Mat& frame, const std::vector<byte_track::BYTETracker::STrackPtr>& tracks);
-    QImage cvMatToQImage(const cv::Mat& mat);
 
     std::shared_ptr<CameraSource> camera_;
-    std::shared_ptr<Inference> inference_;
-    std::unique_ptr<byte_track::BYTETracker> tracker_;
+    std::shared_ptr<CameraPipeline> pipeline_;
 
     QString cameraName_;
     RegionDrawingWidget* videoLabel_;
     QLabel* infoLabel_;
     QPushButton* startStopButton_;
     QPushButton* removeButton_;
-    QTimer* timer_;
-
-    bool isRunning_;
-    cv::Mat currentFrame_;
 
-    // Track ID -> class ID mapping for consistent labeling
-    std::map<size_t, int> trackClassMap_;
+    // Last frame shown, kept for the reconnect banner
+    QImage lastImage_;
 
-    // Region-based detection
+    // Region-based detection (edited here, copied to the pipeline on every change)
     std::vector<Region> regions_;
-
-    // Unique object tracking per region
-    std::map<std::string, std::set<size_t>> regionUniqueObjectIds_;
-
-    // Event capture state tracking
-    struct TrackRegionState {
-        bool inRegion = false;
-        std::string regionName;
-        int lastCaptureFrame = 0;
-        int entryFrame = 0;
-    };
-    std::map<size_t, TrackRegionState> trackRegionStates_;
-    int currentFrameNumber_;
-
-    // Telegram throttling (region name -> last send timestamp in ms)
-    std::map<std::string, qint64> lastTelegramSendTime_;
-    static constexpr int TELEGRAM_THROTTLE_MS = 5000;  // 5 seconds
-
-    void captureEvent(size_t trackId, const std::string& regionName,
-                      const cv::Rect& bbox, EventType eventType);
 };
 
 #endif // CAMERAWIDGET_H
@@ -4,7 +4,7 @@
 #include <string>
 #include <opencv2/opencv.hpp>
 #include <QDateTime>
-#include <QPixmap>
+#include <QImage>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -41,12 +41,12 @@ public:
     QDateTime getTimestamp() const { return timestamp_; }
     cv::Rect getBoundingBox() const { return bbox_; }
     std::string getImagePath() const { return imagePath_; }
-    QPixmap getThumbnail() const { return thumbnail_; }
+    QImage getThumbnail() const { return thumbnail_; }
     int getFrameNumber() const { return frameNumber_; }
 
     // Setters
     void setImagePath(const std::string& path) { imagePath_ = path; }
-    void setThumbnail(const QPixmap& pixmap) { thumbnail_ = pixmap; }
+    void setThumbnail(const QImage& image) { thumbnail_ = image; }
     void setFrameNumber(int frame) { frameNumber_ = frame; }
 
     // Utility
@@ -68,7 +68,7 @@ private:
     QDateTime timestamp_;
     cv::Rect bbox_;
     std::string imagePath_;
-    QPixmap thumbnail_;
+    QImage thumbnail_;  // Not a QPixmap: events are created on pipeline workers, pixmaps belong to the GUI thread
     int frameNumber_;
 };
 
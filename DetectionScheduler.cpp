@@ -0,0 +1,115 @@
+#include "DetectionScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Weight of the newest sample in the latency and velocity averages
+constexpr double kSmoothing = 0.5;
+
+inline cv::Point2f center(const cv::Rect& box) {
+    return cv::Point2f(box.x + box.width * 0.5f, box.y + box.height * 0.5f);
+}
+
+} // namespace
+
+DetectionScheduler::DetectionScheduler(const Config& config) {
+    setConfig(config);
+}
+
+void DetectionScheduler::setConfig(const Config& config) {
+    config_ = config;
+    config_.minInterval = std::max(1, config_.minInterval);
+    config_.maxInterval = std::max(config_.minInterval, config_.maxInterval);
+    config_.frameBudgetMs = std::max(1.0, config_.frameBudgetMs);
+    interval_ = std::clamp(interval_, config_.minInterval, config_.maxInterval);
+}
+
+bool DetectionScheduler::shouldDetect() {
+    if (framesSinceEntry_ >= 0) {
+        ++framesSinceEntry_;
+    }
+
+    if (!config_.enabled || !hasDetected_ || framesSinceDetection_ + 1 >= interval_) {
+        return true;
+    }
+
+    ++framesSinceDetection_;
+    return false;
+}
+
+void DetectionScheduler::reportLatency(double latencyMs) {
+    latencyMs_ = latencyMs_ <= 0.0 ? latencyMs
+                                   : (1.0 - kSmoothing) * latencyMs_ + kSmoothing * latencyMs;
+}
+
+void DetectionScheduler::reportRegionEntry() {
+    framesSinceEntry_ = 0;
+    interval_ = config_.minInterval;
+}
+
+void DetectionScheduler::updateTracks(const std::vector<TrackedBox>& tracks) {
+    const float elapsed = static_cast<float>(framesSinceDetection_ + 1);
+
+    std::map<size_t, TrackMotion> motions;
+    for (const auto& track : tracks) {
+        TrackMotion motion;
+        motion.last = track;
+
+        auto it = motions_.find(track.trackId);
+        if (it != motions_.end()) {
+            cv::Point2f step = (center(track.box) - center(it->second.last.box)) * (1.0f / elapsed);
+            motion.velocity = it->second.velocity * static_cast<float>(1.0 - kSmoothing) +
+                              step * static_cast<float>(kSmoothing);
+        }
+        motions[track.trackId] = motion;
+    }
+
+    // Tracks missing from this update are gone; nothing to extrapolate
+    motions_.swap(motions);
+    framesSinceDetection_ = 0;
+    hasDetected_ = true;
+
+    updateInterval(tracks.size());
+}
+
+std::vector<TrackedBox> DetectionScheduler::predictTracks() const {
+    std::vector<TrackedBox> predicted;
+    predicted.reserve(motions_.size());
+
+    const float frames = static_cast<float>(framesSinceDetection_);
+    for (const auto& entry : motions_) {
+        TrackedBox track = entry.second.last;
+        track.box.x += static_cast<int>(std::lround(entry.second.velocity.x * frames));
+        track.box.y += static_cast<int>(std::lround(entry.second.velocity.y * frames));
+        predicted.push_back(track);
+    }
+
+    return predicted;
+}
+
+void DetectionScheduler::reset() {
+    motions_.clear();
+    latencyMs_ = 0.0;
+    interval_ = config_.minInterval;
+    framesSinceDetection_ = 0;
+    framesSinceEntry_ = -1;
+    hasDetected_ = false;
+}
+
+void DetectionScheduler::updateInterval(size_t trackCount) {
+    // Detecting more often than results come back only queues frames
+    int latencyFloor = static_cast<int>(std::lround(latencyMs_ / config_.frameBudgetMs));
+    latencyFloor = std::clamp(latencyFloor, config_.minInterval, config_.maxInterval);
+
+    const bool recentEntry = framesSinceEntry_ >= 0 && framesSinceEntry_ < config_.entryHoldFrames;
+    const bool busy = static_cast<int>(trackCount) >= config_.busyTrackCount;
+
+    if (recentEntry || busy) {
+        interval_ = latencyFloor;
+    } else if (trackCount == 0) {
+        interval_ = config_.maxInterval;
+    } else {
+        interval_ = std::max(latencyFloor, (config_.minInterval + config_.maxInterval + 1) / 2);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef DETECTIONSCHEDULER_H
+#define DETECTIONSCHEDULER_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <opencv2/core.hpp>
+
+// A track as seen by the region/event logic: tracker output or a predicted box
+struct TrackedBox {
+    size_t trackId = 0;
+    cv::Rect box;
+    float score = 0.0f;
+};
+
+/**
+ * @brief Per-camera scheduler that runs the detector every K frames
+ *
+ * On the frames in between, the tracker itself only runs its prediction
+ * step (see RegionTracker::predict), and the boxes of the last tracker
+ * update are carried forward with a constant-velocity estimate for the
+ * region and event logic. K adapts to:
+ *  - inference latency: K is never below latency / frame budget
+ *  - scene activity: an idle scene (no tracks) uses maxInterval, a busy
+ *    scene or a recent region entry detects as often as latency allows
+ */
+class DetectionScheduler {
+public:
+    struct Config {
+        bool enabled = false;
+        int minInterval = 1;         // Detect at least every minInterval frames when active
+        int maxInterval = 4;         // Never skip more than maxInterval - 1 frames
+        double frameBudgetMs = 33.0; // Camera frame period
+        int busyTrackCount = 8;      // Tracks at which the scene counts as busy
+        int entryHoldFrames = 30;    // Frames after a region entry kept at full rate
+    };
+
+    DetectionScheduler() = default;
+    explicit DetectionScheduler(const Config& config);
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Decide for the next frame; call exactly once per frame
+     * @return true to run the detector, false for a tracker-only frame
+     */
+    bool shouldDetect();
+
+    // Latency of the last detection (submit to result) in milliseconds
+    void reportLatency(double latencyMs);
+
+    // An object entered a region; keeps the detector at full rate for a while
+    void reportRegionEntry();
+
+    // Tracker output of a detection frame; updates velocities and the interval
+    void updateTracks(const std::vector<TrackedBox>& tracks);
+
+    // Boxes of the last update extrapolated to the current tracker-only frame
+    std::vector<TrackedBox> predictTracks() const;
+
+    int getInterval() const { return interval_; }
+    void reset();
+
+private:
+    struct TrackMotion {
+        TrackedBox last;
+        cv::Point2f velocity;  // Pixels per frame
+    };
+
+    void updateInterval(size_t trackCount);
+
+    Config config_;
+    std::map<size_t, TrackMotion> motions_;
+    double latencyMs_ = 0.0;
+    int interval_ = 1;
+    int framesSinceDetection_ = 0;
+    int framesSinceEntry_ = -1;  // -1 = no entry seen yet
+    bool hasDetected_ = false;
+};
+
+#endif // DETECTIONSCHEDULER_H
@@ -0,0 +1,219 @@
+#include "DetectorBackend.h"
+#include "OpenCvDnnBackend.h"
+#include "OnnxRuntimeBackend.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <set>
+
+namespace
+{
+
+// Just enough of the protobuf wire format to walk ModelProto.graph.node[].op_type
+class ProtoReader
+{
+public:
+    ProtoReader(const uchar *data, size_t size) : pos(data), end(data + size) {}
+
+    bool atEnd() const { return pos >= end; }
+
+    // Next field key; false at the end or on malformed input
+    bool nextField(uint32_t &field, uint32_t &wireType)
+    {
+        uint64_t key;
+        if (atEnd() || !readVarint(key))
+            return false;
+        field = static_cast<uint32_t>(key >> 3);
+        wireType = static_cast<uint32_t>(key & 7);
+        return true;
+    }
+
+    // Payload of a length-delimited field (wire type 2)
+    bool readBytes(const uchar *&data, size_t &size)
+    {
+        uint64_t length;
+        if (!readVarint(length) || length > static_cast<uint64_t>(end - pos))
+            return false;
+        data = pos;
+        size = static_cast<size_t>(length);
+        pos += size;
+        return true;
+    }
+
+    bool skip(uint32_t wireType)
+    {
+        uint64_t value;
+        const uchar *data;
+        size_t size;
+        switch (wireType)
+        {
+        case 0:
+            return readVarint(value);
+        case 1:
+            return advance(8);
+        case 2:
+            return readBytes(data, size);
+        case 5:
+            return advance(4);
+        default:
+            return false;  // Groups are not used by ONNX
+        }
+    }
+
+private:
+    bool readVarint(uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos < end; shift += 7)
+        {
+            uchar byte = *pos++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool advance(size_t count)
+    {
+        if (count > static_cast<size_t>(end - pos))
+            return false;
+        pos += count;
+        return true;
+    }
+
+    const uchar *pos;
+    const uchar *end;
+};
+
+// ONNX field numbers (onnx.proto)
+constexpr uint32_t kModelGraph = 7;
+constexpr uint32_t kGraphNode = 1;
+constexpr uint32_t kNodeOpType = 4;
+
+// Collects the op_type of every top-level node; false if the buffer is not a readable ModelProto
+bool readGraphOpTypes(const std::vector<uchar> &onnxModelBuffer, std::set<std::string> &opTypes)
+{
+    ProtoReader model(onnxModelBuffer.data(), onnxModelBuffer.size());
+    uint32_t field, wireType;
+    bool foundGraph = false;
+    while (model.nextField(field, wireType))
+    {
+        if (field != kModelGraph || wireType != 2)
+        {
+            if (!model.skip(wireType))
+                return false;
+            continue;
+        }
+
+        const uchar *graphData;
+        size_t graphSize;
+        if (!model.readBytes(graphData, graphSize))
+            return false;
+        foundGraph = true;
+
+        ProtoReader graph(graphData, graphSize);
+        while (graph.nextField(field, wireType))
+        {
+            if (field != kGraphNode || wireType != 2)
+            {
+                if (!graph.skip(wireType))
+                    return false;
+                continue;
+            }
+
+            const uchar *nodeData;
+            size_t nodeSize;
+            if (!graph.readBytes(nodeData, nodeSize))
+                return false;
+
+            ProtoReader node(nodeData, nodeSize);
+            while (node.nextField(field, wireType))
+            {
+                if (field == kNodeOpType && wireType == 2)
+                {
+                    const uchar *opData;
+                    size_t opSize;
+                    if (!node.readBytes(opData, opSize))
+                        return false;
+                    opTypes.insert(std::string(reinterpret_cast<const char *>(opData), opSize));
+                }
+                else if (!node.skip(wireType))
+                {
+                    return false;
+                }
+            }
+            if (!node.atEnd())
+                return false;
+        }
+        if (!graph.atEnd())
+            return false;
+    }
+    return foundGraph && model.atEnd();
+}
+
+} // namespace
+
+std::unique_ptr<DetectorBackend> createDetectorBackend(const std::vector<uchar> &onnxModelBuffer,
+                                                       const BackendOptions &options)
+{
+    if (options.type == BackendType::OnnxRuntime)
+    {
+#ifdef USE_ONNXRUNTIME
+        if (options.useCuda)
+            std::cout << "⚠️  ONNX Runtime backend is CPU only, ignoring CUDA" << std::endl;
+        return std::make_unique<OnnxRuntimeBackend>(onnxModelBuffer, options);
+#else
+        std::cout << "⚠️  Built without ONNX Runtime (USE_ONNXRUNTIME), using OpenCV DNN" << std::endl;
+#endif
+    }
+
+    return std::make_unique<OpenCvDnnBackend>(onnxModelBuffer, options.useCuda);
+}
+
+ModelPrecision detectModelPrecision(const std::vector<uchar> &onnxModelBuffer)
+{
+    // Decided by the graph's node types, not by names that may also appear in metadata or doc strings
+    static const std::string quantizedOps[] = {"QuantizeLinear", "DequantizeLinear", "QLinearConv",
+                                               "QLinearMatMul", "ConvInteger", "MatMulInteger"};
+
+    std::set<std::string> opTypes;
+    if (!readGraphOpTypes(onnxModelBuffer, opTypes))
+    {
+        std::cout << "⚠️  Could not read the model graph, assuming FP32 precision" << std::endl;
+        return ModelPrecision::FP32;
+    }
+
+    for (const std::string &op : quantizedOps)
+    {
+        if (opTypes.count(op))
+            return ModelPrecision::INT8;
+    }
+
+    return ModelPrecision::FP32;
+}
+
+const char *modelPrecisionName(ModelPrecision precision)
+{
+    switch (precision)
+    {
+    case ModelPrecision::FP16:
+        return "FP16";
+    case ModelPrecision::INT8:
+        return "INT8";
+    default:
+        return "FP32";
+    }
+}
+
+BackendType backendTypeFromString(const std::string &name)
+{
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (lower == "onnxruntime" || lower == "ort")
+        return BackendType::OnnxRuntime;
+
+    return BackendType::OpenCvDnn;
+}
@@ -0,0 +1,78 @@
+#ifndef DETECTORBACKEND_H
+#define DETECTORBACKEND_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+
+// Runtime that executes the ONNX graph; decode and NMS sit on top of any of them
+enum class BackendType
+{
+    OpenCvDnn,
+    OnnxRuntime
+};
+
+// Numeric precision of a model's weights/activations
+enum class ModelPrecision
+{
+    FP32,
+    FP16,
+    INT8  // QDQ (QuantizeLinear/DequantizeLinear) or QLinear* operators
+};
+
+struct BackendOptions
+{
+    BackendType type{BackendType::OpenCvDnn};
+    bool useCuda{false};
+    int intraOpThreads{0};  // ONNX Runtime: threads inside one operator (0 = runtime default)
+    int interOpThreads{0};  // ONNX Runtime: operators run in parallel (0 = runtime default, sequential)
+};
+
+/**
+ * @brief Abstract detector runtime
+ *
+ * A backend takes the letterboxed NCHW float blob built by
+ * LetterboxPreprocessor and returns the raw model output as a
+ * (batch, a, b) float tensor, which YoloDecoder reads in place.
+ * Implementations are not thread-safe; Inference serializes forward calls
+ * and decodes the output before releasing its lock.
+ */
+class DetectorBackend
+{
+public:
+    virtual ~DetectorBackend() = default;
+
+    virtual std::string getName() const = 0;
+
+    // Precision the model runs at (input/output tensors are converted to and from float32)
+    virtual ModelPrecision getPrecision() const = 0;
+
+    /**
+     * @brief Run one forward pass
+     * @param blob NCHW CV_32F input, batch = blob.size[0]
+     * @return First model output; may share memory with the runtime, so it is
+     *         only valid until the next forward call
+     * @throws std::exception if the runtime rejects the input (e.g. batch > 1 on a static model)
+     */
+    virtual cv::Mat forward(const cv::Mat &blob) = 0;
+};
+
+/**
+ * @brief Create a backend for an ONNX model held in memory
+ *
+ * Falls back to OpenCV DNN (with a warning) if ONNX Runtime was requested
+ * but the build has no USE_ONNXRUNTIME support.
+ */
+std::unique_ptr<DetectorBackend> createDetectorBackend(const std::vector<uchar> &onnxModelBuffer,
+                                                       const BackendOptions &options);
+
+// Parse "opencv" / "onnxruntime" (case-insensitive); unknown names select OpenCV DNN
+BackendType backendTypeFromString(const std::string &name);
+
+// INT8 if the graph contains quantization operators, FP32 otherwise (FP16 is reported by the backend)
+ModelPrecision detectModelPrecision(const std::vector<uchar> &onnxModelBuffer);
+
+const char *modelPrecisionName(ModelPrecision precision);
+
+#endif // DETECTORBACKEND_H
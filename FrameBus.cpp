@@ -0,0 +1,61 @@
+#include "FrameBus.h"
+#include <algorithm>
+
+bool FrameBus::Subscriber::takeLatest(AnnotatedFrame& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!fresh_) {
+        return false;
+    }
+    frame = std::move(latest_);
+    latest_ = AnnotatedFrame();
+    fresh_ = false;
+    return true;
+}
+
+void FrameBus::Subscriber::offer(const AnnotatedFrame& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_ = frame;
+    fresh_ = true;
+}
+
+FrameBus& FrameBus::getInstance() {
+    static FrameBus instance;
+    return instance;
+}
+
+std::shared_ptr<FrameBus::Subscriber> FrameBus::subscribe(int cameraId) {
+    auto subscriber = std::make_shared<Subscriber>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_[cameraId].push_back(subscriber);
+    return subscriber;
+}
+
+void FrameBus::unsubscribe(int cameraId, const std::shared_ptr<Subscriber>& subscriber) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(cameraId);
+    if (it == subscribers_.end()) {
+        return;
+    }
+
+    auto& list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), subscriber), list.end());
+    if (list.empty()) {
+        subscribers_.erase(it);
+    }
+}
+
+bool FrameBus::hasSubscribers(int cameraId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_.count(cameraId) > 0;
+}
+
+void FrameBus::publish(int cameraId, const AnnotatedFrame& frame) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscribers_.find(cameraId);
+    if (it == subscribers_.end()) {
+        return;
+    }
+    for (const auto& subscriber : it->second) {
+        subscriber->offer(frame);
+    }
+}
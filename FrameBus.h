@@ -0,0 +1,71 @@
+#ifndef FRAMEBUS_H
+#define FRAMEBUS_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+// Output of a camera's pipeline for one frame
+struct AnnotatedFrame {
+    cv::Mat image;  // Regions, tracks and overlays drawn in; subscribers must not draw into it
+    uint64_t frameNumber = 0;
+    size_t trackCount = 0;
+    size_t detectionCount = 0;
+    std::map<std::string, int> regionCounts;  // Unique objects per region
+};
+
+/**
+ * @brief Publish/subscribe bus for annotated camera output
+ *
+ * A camera's pipeline publishes every processed frame under its camera ID;
+ * extra views (full screen) subscribe to it instead of reading the source
+ * and running their own detection. Each subscriber keeps only the newest
+ * frame. Publishers check hasSubscribers() first, so an unwatched camera
+ * pays nothing. Thread-safe.
+ */
+class FrameBus {
+public:
+    class Subscriber {
+    public:
+        // Newest frame since the last call (non-blocking)
+        bool takeLatest(AnnotatedFrame& frame);
+
+    private:
+        friend class FrameBus;
+        void offer(const AnnotatedFrame& frame);
+
+        std::mutex mutex_;
+        AnnotatedFrame latest_;
+        bool fresh_ = false;
+    };
+
+    // Singleton access
+    static FrameBus& getInstance();
+
+    // Delete copy/move constructors and assignment operators
+    FrameBus(const FrameBus&) = delete;
+    FrameBus& operator=(const FrameBus&) = delete;
+    FrameBus(FrameBus&&) = delete;
+    FrameBus& operator=(FrameBus&&) = delete;
+
+    std::shared_ptr<Subscriber> subscribe(int cameraId);
+    void unsubscribe(int cameraId, const std::shared_ptr<Subscriber>& subscriber);
+
+    bool hasSubscribers(int cameraId) const;
+
+    // The image is shared with the subscribers, not copied
+    void publish(int cameraId, const AnnotatedFrame& frame);
+
+private:
+    FrameBus() = default;
+    ~FrameBus() = default;
+
+    mutable std::mutex mutex_;
+    std::map<int, std::vector<std::shared_ptr<Subscriber>>> subscribers_;
+};
+
+#endif // FRAMEBUS_H
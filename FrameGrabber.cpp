@@ -0,0 +1,265 @@
+#include "FrameGrabber.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+FrameGrabber::FrameGrabber(const std::string& name, std::shared_ptr<FramePool> pool)
+    : name_(name), pool_(std::move(pool)) {
+}
+
+FrameGrabber::~FrameGrabber() {
+    stop();
+}
+
+bool FrameGrabber::start(const CaptureSpec& spec) {
+    stop();
+    spec_ = spec;
+
+    captured_.store(0, std::memory_order_relaxed);
+    outageCount_.store(0, std::memory_order_relaxed);
+    lastOutageMs_.store(0, std::memory_order_relaxed);
+    totalOutageMs_.store(0, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    frameRequested_.store(false, std::memory_order_relaxed);
+    stopRequested_.store(false, std::memory_order_relaxed);
+
+    if (spec_.reconnect.enabled) {
+        // Opening a network stream can take seconds; do it on the capture thread
+        state_.store(ConnectionState::Connecting, std::memory_order_release);
+    } else {
+        if (!openCapture()) {
+            state_.store(ConnectionState::Disconnected, std::memory_order_release);
+            return false;
+        }
+        state_.store(ConnectionState::Connected, std::memory_order_release);
+    }
+
+    opened_.store(true, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&FrameGrabber::run, this);
+    return true;
+}
+
+bool FrameGrabber::openCapture() {
+    std::vector<int> params;
+    if (spec_.timeoutMs > 0) {
+        params = {cv::CAP_PROP_OPEN_TIMEOUT_MSEC, spec_.timeoutMs,
+                  cv::CAP_PROP_READ_TIMEOUT_MSEC, spec_.timeoutMs};
+    }
+
+    try {
+        if (spec_.isDevice) {
+            capture_.open(std::stoi(spec_.source), cv::CAP_ANY, params);
+        } else {
+            capture_.open(spec_.source, cv::CAP_ANY, params);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error opening camera '" << name_ << "': " << e.what() << std::endl;
+        capture_.release();
+        return false;
+    }
+
+    if (!capture_.isOpened()) {
+        return false;
+    }
+
+    paceFps_ = 0.0;
+    if (spec_.paceToSourceFps) {
+        double fps = capture_.get(cv::CAP_PROP_FPS);
+        paceFps_ = (fps > 0.0 && fps <= 240.0) ? fps : 30.0;
+    }
+    return true;
+}
+
+void FrameGrabber::stop() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        stopRequested_.store(true, std::memory_order_release);
+    }
+    waitCondition_.notify_all();
+
+    if (thread_.joinable()) {
+        // A blocked read returns at the latest after the stream's read timeout
+        thread_.join();
+    }
+    if (capture_.isOpened()) {
+        capture_.release();
+    }
+    running_.store(false, std::memory_order_release);
+    opened_.store(false, std::memory_order_release);
+    state_.store(ConnectionState::Disconnected, std::memory_order_release);
+}
+
+bool FrameGrabber::Subscriber::takeLatest(CapturedFrame& frame) {
+    // The consumer keeps the image; its buffer returns to the pool once every
+    // subscriber has dropped its reference
+    return frames_.read(frame);
+}
+
+void FrameGrabber::Subscriber::offer(CapturedFrame&& frame) {
+    if (frames_.write(std::move(frame))) {
+        // The consumer never saw the replaced frame; the buffer already dropped our reference to it
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Held while the listener runs, so setListener() returns only once the old one has finished
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    if (listener_) {
+        listener_();
+    }
+}
+
+void FrameGrabber::Subscriber::setListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    listener_ = std::move(listener);
+}
+
+std::shared_ptr<FrameGrabber::Subscriber> FrameGrabber::subscribe() {
+    auto subscriber = std::make_shared<Subscriber>();
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    subscribers_.push_back(subscriber);
+    return subscriber;
+}
+
+void FrameGrabber::unsubscribe(const std::shared_ptr<Subscriber>& subscriber) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    subscribers_.erase(std::remove(subscribers_.begin(), subscribers_.end(), subscriber), subscribers_.end());
+}
+
+size_t FrameGrabber::getSubscriberCount() const {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    return subscribers_.size();
+}
+
+void FrameGrabber::publish(CapturedFrame& frame) {
+    std::lock_guard<std::mutex> lock(subscribersMutex_);
+    if (subscribers_.empty()) {
+        return;
+    }
+
+    // Every subscriber gets a reference to the same buffer; the last one takes ours,
+    // so a single subscriber holds the only reference
+    for (size_t i = 0; i + 1 < subscribers_.size(); ++i) {
+        CapturedFrame copy = frame;
+        subscribers_[i]->offer(std::move(copy));
+    }
+    subscribers_.back()->offer(std::move(frame));
+}
+
+bool FrameGrabber::waitBeforeRetry(int attempt) {
+    const ReconnectPolicy& policy = spec_.reconnect;
+    double delayMs = policy.initialDelayMs * std::pow(std::max(1.0, policy.multiplier), attempt);
+    delayMs = std::min(delayMs, static_cast<double>(policy.maxDelayMs));
+
+    std::uniform_real_distribution<double> jitter(-policy.jitter, policy.jitter);
+    delayMs = std::max(0.0, delayMs * (1.0 + jitter(jitterRng_)));
+
+    std::cout << "🔄 Camera '" << name_ << "': reconnect attempt " << (attempt + 1)
+              << " in " << static_cast<int>(delayMs) << " ms" << std::endl;
+
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    return !waitCondition_.wait_for(lock, std::chrono::duration<double, std::milli>(delayMs), [this] {
+        return stopRequested_.load(std::memory_order_acquire);
+    });
+}
+
+void FrameGrabber::run() {
+    using Clock = std::chrono::steady_clock;
+    Clock::duration frameInterval = Clock::duration::zero();
+    Clock::time_point nextFrameTime = Clock::now();
+    Clock::time_point outageStart = Clock::now();
+    uint64_t sequence = 0;
+    int attempt = 0;
+
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        if (!capture_.isOpened()) {
+            // Connecting or Reconnecting: every (re)open happens here, never on the consumer's thread
+            if (!openCapture()) {
+                if (!waitBeforeRetry(attempt++)) {
+                    break;
+                }
+                continue;
+            }
+
+            if (state_.load(std::memory_order_relaxed) == ConnectionState::Reconnecting) {
+                int64_t outageMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - outageStart).count();
+                lastOutageMs_.store(outageMs, std::memory_order_relaxed);
+                totalOutageMs_.fetch_add(outageMs, std::memory_order_relaxed);
+                std::cout << "✅ Camera '" << name_ << "' reconnected after " << outageMs << " ms" << std::endl;
+            }
+            state_.store(ConnectionState::Connected, std::memory_order_release);
+            attempt = 0;
+        }
+
+        if (frameInterval == Clock::duration::zero() && paceFps_ > 0.0) {
+            frameInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / paceFps_));
+            nextFrameTime = Clock::now();
+        }
+
+        CapturedFrame decoded;
+        decoded.image = pool_->borrow();
+        bool ok = spec_.decodeOnDemand ? capture_.grab() : capture_.read(decoded.image) && !decoded.image.empty();
+        if (!ok) {
+            if (!spec_.reconnect.enabled) {
+                std::cerr << "Failed to read frame from camera '" << name_ << "'" << std::endl;
+                state_.store(ConnectionState::Failed, std::memory_order_release);
+                failed_.store(true, std::memory_order_release);
+                break;
+            }
+
+            std::cerr << "🔌 Camera '" << name_ << "' lost, reconnecting..." << std::endl;
+            capture_.release();
+            outageStart = Clock::now();
+            outageCount_.fetch_add(1, std::memory_order_relaxed);
+            state_.store(ConnectionState::Reconnecting, std::memory_order_release);
+            continue;
+        }
+
+        ++sequence;
+        if (spec_.decodeOnDemand) {
+            // Packets are grabbed continuously to keep the stream current; only a requested frame is converted
+            captured_.fetch_add(1, std::memory_order_relaxed);
+            if (!frameRequested_.exchange(false, std::memory_order_acq_rel)) {
+                continue;
+            }
+            if (!capture_.retrieve(decoded.image) || decoded.image.empty()) {
+                continue;
+            }
+            decoded.timestamp = Clock::now();
+            decoded.sequence = sequence;
+            publish(decoded);
+            continue;
+        }
+
+        const Clock::time_point timestamp = Clock::now();
+        decoded.timestamp = timestamp;
+        decoded.sequence = sequence;
+        if (sequence == 1) {
+            // Triple buffer + current, in-flight and display frames
+            pool_->reserve(6, decoded.image.rows, decoded.image.cols, decoded.image.type());
+        }
+        captured_.fetch_add(1, std::memory_order_relaxed);
+        publish(decoded);
+
+        if (frameInterval > Clock::duration::zero()) {
+            nextFrameTime += frameInterval;
+            if (nextFrameTime > timestamp) {
+                std::this_thread::sleep_until(nextFrameTime);
+            } else {
+                nextFrameTime = timestamp;  // Decoder fell behind; don't try to catch up
+            }
+        }
+    }
+
+    running_.store(false, std::memory_order_release);
+}
+
+const char* FrameGrabber::connectionStateName(ConnectionState state) {
+    switch (state) {
+        case ConnectionState::Connecting: return "Connecting";
+        case ConnectionState::Connected: return "Connected";
+        case ConnectionState::Reconnecting: return "Reconnecting";
+        case ConnectionState::Failed: return "Failed";
+        default: return "Disconnected";
+    }
+}
@@ -0,0 +1,200 @@
+#ifndef FRAMEGRABBER_H
+#define FRAMEGRABBER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "FramePool.h"
+#include "TripleBuffer.h"
+
+// A decoded frame with the time it left the decoder and its position in the stream
+struct CapturedFrame {
+    cv::Mat image;
+    std::chrono::steady_clock::time_point timestamp;
+    uint64_t sequence = 0;  // 1 for the first frame after start(), +1 per decoded frame
+};
+
+/**
+ * @brief Capture thread for one video source
+ *
+ * The thread reads frames as fast as the source delivers them and fans each
+ * one out to every subscriber. A subscriber is a lock-free triple buffer: the
+ * newest frame always wins, and a frame its consumer never picked up is
+ * counted as dropped. Consumers never block on the decoder, so a stalled
+ * stream cannot hold up the GUI thread, and OpenCV's internal queue is
+ * drained continuously instead of serving stale frames.
+ *
+ * Subscribers share the decoded image (one buffer, reference counted by
+ * OpenCV); see SourceRegistry for how cameras on the same source share one
+ * grabber.
+ *
+ * With a reconnect policy, a failed open or read does not end the thread:
+ * the capture is released and reopened after an exponential backoff with
+ * jitter, entirely on the capture thread, so an outage never blocks the
+ * consumer or other cameras.
+ *
+ * With decodeOnDemand the thread only grabs packets, which keeps the stream
+ * current, and converts a frame to BGR only when requestFrame() asks for one
+ * (the high-resolution main stream of a dual-stream camera). The converted
+ * frame is published like any other; nobody waits for it.
+ *
+ * Single producer (the capture thread), one consumer per subscriber.
+ */
+class FrameGrabber {
+public:
+    // One consumer's view of the stream
+    class Subscriber {
+    public:
+        /**
+         * @brief Take the newest frame (non-blocking)
+         * @return false if no frame was published since the last call
+         *
+         * The image may be shared with other subscribers of the same grabber.
+         */
+        bool takeLatest(CapturedFrame& frame);
+
+        bool hasFreshFrame() const { return frames_.hasFresh(); }
+
+        // Called on the capture thread after every published frame; must not block.
+        // Once setListener() returns, the previous listener is no longer running.
+        void setListener(std::function<void()> listener);
+
+        // Frames replaced by a newer one before this consumer took them
+        uint64_t getDroppedFrames() const { return dropped_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class FrameGrabber;
+        void offer(CapturedFrame&& frame);  // Capture thread only
+
+        // Written by the capture thread, read by the consumer
+        TripleBuffer<CapturedFrame> frames_;
+        std::atomic<uint64_t> dropped_{0};
+
+        std::mutex listenerMutex_;
+        std::function<void()> listener_;  // Guarded by listenerMutex_
+    };
+
+    enum class ConnectionState {
+        Disconnected,  // Not started, or stopped
+        Connecting,    // First open in progress (reconnecting sources open on the thread)
+        Connected,
+        Reconnecting,  // Lost after having delivered frames; retrying with backoff
+        Failed         // Source ended and will not be retried (end of file, no reconnect policy)
+    };
+
+    // Retry delays: initialDelayMs * multiplier^attempt, capped at maxDelayMs, +/- jitter
+    struct ReconnectPolicy {
+        bool enabled = false;
+        int initialDelayMs = 500;
+        int maxDelayMs = 30000;
+        double multiplier = 2.0;
+        double jitter = 0.2;  // Fraction of the delay; spreads out cameras that failed together
+    };
+
+    // What to open and how to read it
+    struct CaptureSpec {
+        std::string source;            // Device index for webcams, otherwise file path / URL
+        bool isDevice = false;
+        bool paceToSourceFps = false;  // Video files: read at the file's frame rate, not as fast as possible
+        int timeoutMs = 0;             // Network streams: open/read timeout (0 = backend default)
+        bool decodeOnDemand = false;   // Only grab() packets; convert a frame when requestFrame() asks for one
+        ReconnectPolicy reconnect;
+    };
+
+    // Frames are decoded into buffers borrowed from `pool`
+    FrameGrabber(const std::string& name, std::shared_ptr<FramePool> pool);
+    ~FrameGrabber();
+
+    FrameGrabber(const FrameGrabber&) = delete;
+    FrameGrabber& operator=(const FrameGrabber&) = delete;
+
+    /**
+     * @brief Open the source and start the capture thread
+     * @return false if the source cannot be opened (no thread is started).
+     *         With a reconnect policy the first open also happens on the thread,
+     *         so this always succeeds and the state starts as Connecting.
+     */
+    bool start(const CaptureSpec& spec);
+
+    // Stop the thread and release the capture
+    void stop();
+
+    // Add / remove a consumer; safe while the capture thread runs
+    std::shared_ptr<Subscriber> subscribe();
+    void unsubscribe(const std::shared_ptr<Subscriber>& subscriber);
+    size_t getSubscriberCount() const;
+
+    // Have a decodeOnDemand source convert and publish its next frame; returns at once
+    // (every frame is published anyway without decodeOnDemand)
+    void requestFrame() { frameRequested_.store(true, std::memory_order_release); }
+
+    // Between a successful start() and stop(), even if the thread has already failed
+    bool isOpened() const { return opened_.load(std::memory_order_acquire); }
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // The thread ended because the source stopped delivering (end of file, stream lost)
+    bool hasFailed() const { return failed_.load(std::memory_order_acquire); }
+
+    uint64_t getCapturedFrames() const { return captured_.load(std::memory_order_relaxed); }
+
+    // Buffers the capture thread decodes into (shared by every subscriber of this source)
+    FramePool::Stats getPoolStats() const { return pool_->getStats(); }
+    const CaptureSpec& getSpec() const { return spec_; }
+
+    ConnectionState getConnectionState() const { return state_.load(std::memory_order_acquire); }
+
+    // Outages are counted from the failed read to the first successful reopen
+    uint64_t getOutageCount() const { return outageCount_.load(std::memory_order_relaxed); }
+    int64_t getLastOutageMs() const { return lastOutageMs_.load(std::memory_order_relaxed); }
+    int64_t getTotalOutageMs() const { return totalOutageMs_.load(std::memory_order_relaxed); }
+
+    static const char* connectionStateName(ConnectionState state);
+
+private:
+    void run();
+    void publish(CapturedFrame& frame);
+    bool openCapture();
+
+    // Sleep before retry `attempt`; false if stop() was requested meanwhile
+    bool waitBeforeRetry(int attempt);
+
+    std::string name_;
+    std::shared_ptr<FramePool> pool_;
+    CaptureSpec spec_;
+    cv::VideoCapture capture_;
+    double paceFps_ = 0.0;  // 0 = read as fast as the source delivers
+    std::thread thread_;
+
+    mutable std::mutex subscribersMutex_;
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+
+    std::atomic<bool> opened_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> failed_{false};
+    std::atomic<uint64_t> captured_{0};
+
+    std::atomic<ConnectionState> state_{ConnectionState::Disconnected};
+    std::atomic<uint64_t> outageCount_{0};
+    std::atomic<int64_t> lastOutageMs_{0};
+    std::atomic<int64_t> totalOutageMs_{0};
+
+    // Interrupts the backoff sleep on stop()
+    std::mutex waitMutex_;
+    std::condition_variable waitCondition_;
+    std::atomic<bool> frameRequested_{false};
+    std::mt19937 jitterRng_{std::random_device{}()};
+};
+
+#endif // FRAMEGRABBER_H
@@ -0,0 +1,199 @@
+#include "FramePool.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+/**
+ * MatAllocator backed by a free list. UMatData only stores a raw allocator
+ * pointer, so the allocator deletes itself once the owning FramePool is gone
+ * and the last borrowed buffer has come back.
+ */
+class FramePool::Allocator : public cv::MatAllocator {
+public:
+    Allocator(size_t maxFreeBuffers, size_t minPooledBytes)
+        : maxFreeBuffers_(maxFreeBuffers), minPooledBytes_(minPooledBytes) {
+    }
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                           cv::AccessFlag /*flags*/, cv::UMatUsageFlags /*usageFlags*/) const override {
+        // Same layout computation as OpenCV's default allocator
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--) {
+            if (step) {
+                if (data0 && step[i] != CV_AUTOSTEP) {
+                    total = step[i];
+                } else {
+                    step[i] = total;
+                }
+            }
+            total *= sizes[i];
+        }
+
+        cv::UMatData* u = new cv::UMatData(this);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++liveBuffers_;
+        }
+        if (data0) {
+            u->data = u->origdata = static_cast<uchar*>(data0);
+            u->flags |= cv::UMatData::USER_ALLOCATED;
+        } else {
+            u->data = u->origdata = takeBuffer(total);
+        }
+        u->size = total;
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, cv::AccessFlag /*accessFlags*/, cv::UMatUsageFlags /*usageFlags*/) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) {
+            return;
+        }
+
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+            returnBuffer(u->origdata, u->size);
+        }
+        delete u;
+
+        bool destroy = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            destroy = --liveBuffers_ == 0 && closed_;
+        }
+        if (destroy) {
+            delete this;
+        }
+    }
+
+    uchar* takeBuffer(size_t size) const {
+        if (size < minPooledBytes_) {
+            return static_cast<uchar*>(cv::fastMalloc(size));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.inUse;
+        stats_.highWaterMark = std::max(stats_.highWaterMark, stats_.inUse);
+
+        auto it = std::find_if(free_.begin(), free_.end(), [size](const Buffer& b) { return b.size == size; });
+        if (it != free_.end()) {
+            uchar* data = it->data;
+            free_.erase(it);
+            ++stats_.reuses;
+            return data;
+        }
+
+        ++stats_.allocations;
+        return static_cast<uchar*>(cv::fastMalloc(size));
+    }
+
+    void returnBuffer(uchar* data, size_t size) const {
+        if (size < minPooledBytes_) {
+            cv::fastFree(data);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        --stats_.inUse;
+        if (closed_) {
+            cv::fastFree(data);
+            return;
+        }
+
+        // Oldest free buffer makes room, so a burst of odd sizes cannot pin the pool
+        if (free_.size() >= maxFreeBuffers_) {
+            cv::fastFree(free_.front().data);
+            free_.pop_front();
+        }
+        free_.push_back({data, size});
+    }
+
+    // Called by ~FramePool; returns true if no Mat refers to the allocator and it can go now
+    bool close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        for (const Buffer& b : free_) {
+            cv::fastFree(b.data);
+        }
+        free_.clear();
+        return liveBuffers_ == 0;
+    }
+
+    void restoreHighWaterMark(size_t mark) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.highWaterMark = std::max(mark, stats_.inUse);
+    }
+
+    FramePool::Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FramePool::Stats stats = stats_;
+        stats.free = free_.size();
+        return stats;
+    }
+
+private:
+    struct Buffer {
+        uchar* data;
+        size_t size;
+    };
+
+    const size_t maxFreeBuffers_;
+    const size_t minPooledBytes_;
+
+    mutable std::mutex mutex_;
+    mutable std::deque<Buffer> free_;
+    mutable FramePool::Stats stats_;
+    mutable size_t liveBuffers_ = 0;  // Every UMatData created here, pooled or not
+    bool closed_ = false;
+};
+
+FramePool::FramePool(const std::string& name, size_t maxFreeBuffers, size_t minPooledBytes)
+    : name_(name), allocator_(new Allocator(std::max<size_t>(1, maxFreeBuffers), minPooledBytes)) {
+}
+
+FramePool::~FramePool() {
+    if (allocator_->close()) {
+        delete allocator_;
+    }
+}
+
+cv::Mat FramePool::borrow() {
+    cv::Mat mat;
+    mat.allocator = allocator_;
+    return mat;
+}
+
+cv::Mat FramePool::borrow(int rows, int cols, int type) {
+    cv::Mat mat = borrow();
+    mat.create(rows, cols, type);
+    return mat;
+}
+
+cv::Mat FramePool::clone(const cv::Mat& src) {
+    cv::Mat mat = borrow();
+    src.copyTo(mat);
+    return mat;
+}
+
+void FramePool::reserve(size_t count, int rows, int cols, int type) {
+    const size_t highWaterMark = allocator_->getStats().highWaterMark;
+
+    std::vector<cv::Mat> buffers;
+    buffers.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        cv::Mat mat = borrow(rows, cols, type);
+        std::memset(mat.data, 0, mat.total() * mat.elemSize());  // Touch every page now
+        buffers.push_back(mat);
+    }
+    buffers.clear();  // All of them return to the free list
+
+    // Pre-faulted buffers are not demand
+    allocator_->restoreHighWaterMark(highWaterMark);
+}
+
+FramePool::Stats FramePool::getStats() const {
+    return allocator_->getStats();
+}
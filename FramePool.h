@@ -0,0 +1,67 @@
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief Pool of reusable full-resolution image buffers
+ *
+ * Each capture source decodes into one (see SourceRegistry), and each
+ * camera has one for its processing, display and snapshot copies.
+ *
+ * Mats borrowed from the pool carry a custom cv::MatAllocator, so every
+ * create() on them (VideoCapture::read, cvtColor, copyTo, ...) takes a buffer
+ * from the pool, and the buffer goes back to the pool when the last Mat
+ * referencing it is released. Reference counting stays OpenCV's own: a
+ * frame handed to the batch engine or a snapshot simply keeps its buffer
+ * out of the pool until it is dropped.
+ *
+ * Buffers are matched by byte size; small allocations (object crops) bypass
+ * the pool. Thread-safe: capture threads allocate, any thread may release.
+ */
+class FramePool {
+public:
+    struct Stats {
+        uint64_t allocations = 0;  // Buffers obtained from the system allocator
+        uint64_t reuses = 0;       // Requests served from the free list
+        size_t inUse = 0;          // Buffers currently borrowed
+        size_t highWaterMark = 0;  // Largest number of buffers borrowed at once
+        size_t free = 0;           // Buffers waiting in the free list
+    };
+
+    /**
+     * @param maxFreeBuffers Free buffers kept for reuse; older ones are released beyond this
+     * @param minPooledBytes Smaller requests use the default allocator
+     */
+    explicit FramePool(const std::string& name, size_t maxFreeBuffers = 12, size_t minPooledBytes = 64 * 1024);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    // Empty Mat whose next create() draws from this pool
+    cv::Mat borrow();
+
+    // Pooled Mat of the given geometry (contents undefined)
+    cv::Mat borrow(int rows, int cols, int type);
+
+    // Deep copy into a pooled buffer (pooled replacement for clone())
+    cv::Mat clone(const cv::Mat& src);
+
+    // Pre-fault `count` buffers of this geometry so the first frames do not pay for page faults
+    void reserve(size_t count, int rows, int cols, int type);
+
+    Stats getStats() const;
+    const std::string& getName() const { return name_; }
+
+private:
+    class Allocator;
+
+    std::string name_;
+    Allocator* allocator_;  // Outlives the pool while buffers are still borrowed
+};
+
+#endif // FRAMEPOOL_H
@@ -4,18 +4,15 @@
 #include <opencv2/opencv.hpp>
 
 FullScreenCameraView::FullScreenCameraView(std::shared_ptr<CameraSource> camera,
-                                         std::shared_ptr<Inference> inference,
                                          QWidget* parent)
-    : QDialog(parent), camera_(camera), inference_(inference) {
+    : QDialog(parent), camera_(camera) {
 
     cameraName_ = QString::fromStdString(camera_->getName());
 
     setupUI();
 
-    // Open camera if not already opened
-    if (!camera_->isOpened()) {
-        camera_->open();
-    }
+    // Output of the camera's existing pipeline; nothing is read or detected here
+    subscriber_ = FrameBus::getInstance().subscribe(camera_->getId());
 
     // Start frame updates
     timer_ = new QTimer(this);
@@ -25,6 +22,7 @@ FullScreenCameraView::FullScreenCameraView(std::shared_ptr<CameraSource> camera,
 
 FullScreenCameraView::~FullScreenCameraView() {
     timer_->stop();
+    FrameBus::getInstance().unsubscribe(camera_->getId(), subscriber_);
 }
 
 void FullScreenCameraView::setupUI() {
@@ -58,51 +56,32 @@ void FullScreenCameraView::setupUI() {
 }
 
 void FullScreenCameraView::updateFrame() {
-    if (!camera_->read(currentFrame_) || currentFrame_.empty()) {
-        videoLabel_->setText("<font color='red' size='5'>Camera feed lost</font>");
-        return;
+    AnnotatedFrame annotated;
+    if (!subscriber_->takeLatest(annotated)) {
+        if (camera_->hasFailed()) {
+            videoLabel_->setText("<font color='red' size='5'>Camera feed lost</font>");
+        }
+        return;  // No new output from the camera's pipeline yet
     }
 
-    // Simple detection visualization (without ByteTrack for simplicity)
-    std::vector<Detection> detections = inference_->runInference(currentFrame_);
-
-    // Draw detections
-    for (const auto& det : detections) {
-        cv::Scalar color(0, 255, 0);
-        cv::rectangle(currentFrame_, det.box, color, 2);
-
-        std::string label = inference_->getClassName(det.class_id) + ": " +
-                          std::to_string(static_cast<int>(det.confidence * 100)) + "%";
+    // The published image is shared with the grid widget; draw into a copy
+    currentFrame_ = camera_->getFramePool()->clone(annotated.image);
 
-        int fontFace = cv::FONT_HERSHEY_SIMPLEX;
-        double fontScale = 0.6;
-        int thickness = 2;
-
-        cv::Size textSize = cv::getTextSize(label, fontFace, fontScale, thickness, 0);
-        cv::Rect textBox(det.box.x, det.box.y - textSize.height - 10,
-                        textSize.width + 10, textSize.height + 10);
-
-        cv::rectangle(currentFrame_, textBox, color, cv::FILLED);
-        cv::putText(currentFrame_, label, cv::Point(det.box.x + 5, det.box.y - 8),
-                   fontFace, fontScale, cv::Scalar(255, 255, 255), thickness, cv::LINE_AA);
+    // Exit hint and unique counts per region (top-right corner)
+    std::vector<std::string> lines = {"Full Screen (Press ESC to exit)"};
+    for (const auto& count : annotated.regionCounts) {
+        lines.push_back(count.first + ": " + std::to_string(count.second));
     }
 
-    // Draw camera name overlay
-    std::string overlayText = cameraName_.toStdString() + " | Full Screen (Press ESC to exit)";
-    cv::Size textSize = cv::getTextSize(overlayText, cv::FONT_HERSHEY_DUPLEX, 1.0, 2, 0);
-    cv::Rect textBox(10, 10, textSize.width + 20, textSize.height + 20);
-    cv::rectangle(currentFrame_, textBox, cv::Scalar(0, 0, 0), cv::FILLED);
-    cv::putText(currentFrame_, overlayText, cv::Point(20, 35),
-               cv::FONT_HERSHEY_DUPLEX, 1.0, cv::Scalar(255, 255, 255), 2, cv::LINE_AA);
-
-    // Display detection count
-    std::string countText = "Detections: " + std::to_string(detections.size());
-    cv::Size countSize = cv::getTextSize(countText, cv::FONT_HERSHEY_SIMPLEX, 0.8, 2, 0);
-    int countY = currentFrame_.rows - 20;
-    cv::Rect countBox(10, countY - countSize.height - 10, countSize.width + 20, countSize.height + 20);
-    cv::rectangle(currentFrame_, countBox, cv::Scalar(0, 0, 0), cv::FILLED);
-    cv::putText(currentFrame_, countText, cv::Point(20, countY - 5),
-               cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(0, 255, 0), 2, cv::LINE_AA);
+    int y = 10;
+    for (const auto& line : lines) {
+        cv::Size textSize = cv::getTextSize(line, cv::FONT_HERSHEY_DUPLEX, 0.8, 2, 0);
+        cv::Rect textBox(currentFrame_.cols - textSize.width - 30, y, textSize.width + 20, textSize.height + 20);
+        cv::rectangle(currentFrame_, textBox, cv::Scalar(0, 0, 0), cv::FILLED);
+        cv::putText(currentFrame_, line, cv::Point(textBox.x + 10, y + textSize.height + 10),
+                   cv::FONT_HERSHEY_DUPLEX, 0.8, cv::Scalar(255, 255, 255), 2, cv::LINE_AA);
+        y += textBox.height + 5;
+    }
 
     // Convert to QImage and display
     QImage qimg = cvMatToQImage(currentFrame_);
@@ -114,16 +93,19 @@ QImage FullScreenCameraView::cvMatToQImage(const cv::Mat& mat) {
         return QImage();
     }
 
-    cv::Mat rgb;
+    cv::Mat rgb = camera_->getFramePool()->borrow();
     if (mat.channels() == 1) {
         cv::cvtColor(mat, rgb, cv::COLOR_GRAY2RGB);
     } else if (mat.channels() == 3) {
         cv::cvtColor(mat, rgb, cv::COLOR_BGR2RGB);
     } else {
-        rgb = mat.clone();
+        mat.copyTo(rgb);
     }
 
-    return QImage(rgb.data, rgb.cols, rgb.rows, rgb.step, QImage::Format_RGB888).copy();
+    // The QImage shares the pooled buffer and returns it to the pool when Qt releases the image
+    cv::Mat* owner = new cv::Mat(rgb);
+    return QImage(owner->data, owner->cols, owner->rows, owner->step, QImage::Format_RGB888,
+                  [](void* info) { delete static_cast<cv::Mat*>(info); }, owner);
 }
 
 void FullScreenCameraView::keyPressEvent(QKeyEvent* event) {
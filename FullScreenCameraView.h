@@ -8,12 +8,14 @@
 #include <QKeyEvent>
 #include <memory>
 #include "CameraSource.h"
-#include "inference.h"
+#include "FrameBus.h"
 
 /**
  * @brief Full screen camera view dialog
  *
- * Displays a single camera in full screen mode.
+ * Displays a single camera in full screen mode: the annotated output of the
+ * camera's own pipeline (tracks, regions, counts), received over the
+ * FrameBus, so the view costs no extra capture or inference.
  * Press ESC or double-click to exit.
  */
 class FullScreenCameraView : public QDialog {
@@ -21,7 +23,6 @@ class FullScreenCameraView : public QDialog {
 
 public:
     explicit FullScreenCameraView(std::shared_ptr<CameraSource> camera,
-                                 std::shared_ptr<Inference> inference,
                                  QWidget* parent = nullptr);
     ~FullScreenCameraView();
 
@@ -37,7 +38,7 @@ private:
     QImage cvMatToQImage(const cv::Mat& mat);
 
     std::shared_ptr<CameraSource> camera_;
-    std::shared_ptr<Inference> inference_;
+    std::shared_ptr<FrameBus::Subscriber> subscriber_;
     QLabel* videoLabel_;
     QTimer* timer_;
     cv::Mat currentFrame_;
@@ -0,0 +1,127 @@
+#include "InferencePool.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+InferencePool::Lease::Lease(InferencePool* pool, int index)
+    : pool_(pool), index_(index), inference_(pool->instances_[index]) {
+}
+
+InferencePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), index_(other.index_), inference_(std::move(other.inference_)) {
+    other.pool_ = nullptr;
+}
+
+InferencePool::Lease::~Lease() {
+    if (pool_) {
+        pool_->release(index_);
+    }
+}
+
+InferencePool::InferencePool(const std::string& onnxModelPath,
+                             const cv::Size& modelInputShape,
+                             const std::string& classesTxtFile,
+                             const BackendOptions& backendOptions,
+                             int poolSize)
+    : modelPath_(onnxModelPath) {
+    if (poolSize <= 0) {
+        poolSize = defaultPoolSize();
+    }
+
+    // Read the model file once; every Net is built from this buffer
+    std::vector<uchar> modelBuffer = Inference::readModelFile(onnxModelPath);
+
+    std::vector<std::string> classNames = Inference::readClassNames(classesTxtFile);
+
+    instances_.reserve(poolSize);
+    for (int i = 0; i < poolSize; ++i) {
+        instances_.push_back(std::make_shared<Inference>(modelBuffer, classNames, modelInputShape, backendOptions));
+        freeIndices_.push_back(i);
+    }
+
+    std::cout << "InferencePool: " << poolSize << " " << instances_.front()->getBackendName()
+              << " instance(s) of " << onnxModelPath
+              << " [" << modelPrecisionName(instances_.front()->getPrecision()) << "]"
+              << " (" << modelBuffer.size() / (1024 * 1024) << " MB model, "
+              << classNames.size() << " class names)" << std::endl;
+}
+
+InferencePool::InferencePool(std::shared_ptr<Inference> inference) {
+    instances_.push_back(inference);
+    freeIndices_.push_back(0);
+}
+
+int InferencePool::defaultPoolSize() {
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::clamp(cores / 4, 1, 8);
+}
+
+void InferencePool::setActiveClasses(const std::set<int>& classIds) {
+    for (const auto& instance : instances_) {
+        instance->setActiveClasses(classIds);
+    }
+}
+
+void InferencePool::setMaxDetections(int maxCount) {
+    for (const auto& instance : instances_) {
+        instance->setMaxDetections(maxCount);
+    }
+}
+
+void InferencePool::setTiling(const TilingConfig& config) {
+    for (const auto& instance : instances_) {
+        instance->setTiling(config);
+    }
+}
+
+void InferencePool::warmUp(int passes) {
+    if (passes <= 0) {
+        return;
+    }
+
+    // Instances are independent Nets, so their lazy initialization can overlap
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> errors(instances_.size());
+    for (size_t i = 0; i < instances_.size(); ++i) {
+        threads.emplace_back([this, i, passes, &errors]() {
+            try {
+                instances_[i]->warmUp(passes);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+std::shared_ptr<Inference> InferencePool::nextInstance() {
+    unsigned index = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+    return instances_[index % instances_.size()];
+}
+
+InferencePool::Lease InferencePool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    available_.wait(lock, [this]() { return !freeIndices_.empty(); });
+
+    int index = freeIndices_.back();
+    freeIndices_.pop_back();
+    return Lease(this, index);
+}
+
+void InferencePool::release(int index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        freeIndices_.push_back(index);
+    }
+    available_.notify_one();
+}
@@ -0,0 +1,122 @@
+#ifndef INFERENCEPOOL_H
+#define INFERENCEPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "inference.h"
+
+/**
+ * @brief Pool of independent Inference instances sharing one model load
+ *
+ * cv::dnn::Net is not thread-safe, so running detection on more than one
+ * core needs one Net per worker thread. The pool reads the ONNX file and the
+ * class list once, then builds K Inference instances from the in-memory
+ * model. Worker threads either pin an instance by index (getInstance) or
+ * borrow any free one for the duration of a call (acquire); cameras that
+ * detect inline are each given one instance in turn (nextInstance).
+ */
+class InferencePool {
+public:
+    /**
+     * @brief RAII handle to a borrowed instance; returned to the pool on destruction
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        Inference* operator->() const { return inference_.get(); }
+        Inference& operator*() const { return *inference_; }
+        const std::shared_ptr<Inference>& get() const { return inference_; }
+
+    private:
+        friend class InferencePool;
+        Lease(InferencePool* pool, int index);
+
+        InferencePool* pool_;
+        int index_;
+        std::shared_ptr<Inference> inference_;
+    };
+
+    /**
+     * @brief Load the model once and build `poolSize` instances
+     * @param backendOptions Runtime used by every instance (see DetectorBackend)
+     * @param poolSize Number of instances (<= 0 picks defaultPoolSize())
+     * @throws std::runtime_error / cv::Exception if the model cannot be loaded
+     */
+    InferencePool(const std::string& onnxModelPath,
+                  const cv::Size& modelInputShape,
+                  const std::string& classesTxtFile,
+                  const BackendOptions& backendOptions,
+                  int poolSize = 0);
+
+    /**
+     * @brief Wrap a single existing instance (pool of one)
+     */
+    explicit InferencePool(std::shared_ptr<Inference> inference);
+
+    InferencePool(const InferencePool&) = delete;
+    InferencePool& operator=(const InferencePool&) = delete;
+
+    /**
+     * @brief Suggested pool size for this machine
+     *
+     * Each forward pass already uses OpenCV's internal thread pool, so one
+     * instance per core oversubscribes the CPU. The default uses one instance
+     * per four hardware threads, between 1 and 8.
+     */
+    static int defaultPoolSize();
+
+    int size() const { return static_cast<int>(instances_.size()); }
+    const std::string& getModelPath() const { return modelPath_; }
+
+    // Instance pinned to a worker thread (index in [0, size()))
+    std::shared_ptr<Inference> getInstance(int index) const { return instances_[index]; }
+
+    // First instance; used for class names and other model metadata
+    std::shared_ptr<Inference> primary() const { return instances_.front(); }
+
+    // Instance for a new long-lived user (a camera detecting inline), round-robin over the pool so
+    // cameras do not all queue on one Net
+    std::shared_ptr<Inference> nextInstance();
+
+    // Apply a class mask to every instance (see Inference::setActiveClasses)
+    void setActiveClasses(const std::set<int>& classIds);
+
+    // Apply a per-frame detection cap to every instance (see Inference::setMaxDetections)
+    void setMaxDetections(int maxCount);
+
+    /**
+     * @brief Warm up every instance in parallel (see Inference::warmUp)
+     * @throws cv::Exception if a forward pass fails
+     */
+    void warmUp(int passes);
+
+    // Apply a tiling configuration to every instance (see Inference::setTiling)
+    void setTiling(const TilingConfig& config);
+
+    // Borrow a free instance, blocking until one is available
+    Lease acquire();
+
+private:
+    void release(int index);
+
+    std::string modelPath_;
+    std::vector<std::shared_ptr<Inference>> instances_;
+    std::atomic<unsigned> nextIndex_{0};
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<int> freeIndices_;
+};
+
+#endif // INFERENCEPOOL_H
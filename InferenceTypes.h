@@ -0,0 +1,23 @@
+#ifndef INFERENCETYPES_H
+#define INFERENCETYPES_H
+
+// Letterbox geometry needed to map model coordinates back to the source frame
+struct LetterboxInfo
+{
+    int pad_x{0};
+    int pad_y{0};
+    float scale{1.0f};
+};
+
+// Tiled inference for high-resolution frames: overlapping crops are detected
+// in one batched forward pass and merged back into frame coordinates
+struct TilingConfig
+{
+    bool enabled{false};
+    int tileSize{960};              // Tile side in source pixels (letterboxed to the model input)
+    float overlap{0.2f};            // Fraction of tileSize shared by neighbouring tiles
+    bool includeFullFrame{true};    // Also detect on the whole frame, for objects larger than a tile
+    float seamMergeThreshold{0.6f}; // Same-class boxes whose overlap covers this much of the smaller one are merged
+};
+
+#endif // INFERENCETYPES_H
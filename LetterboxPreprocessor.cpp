@@ -0,0 +1,99 @@
+#include "LetterboxPreprocessor.h"
+#include <algorithm>
+
+LetterboxPreprocessor::LetterboxPreprocessor(const cv::Size &inputShape)
+    : inputShape_(inputShape)
+{
+}
+
+cv::Mat LetterboxPreprocessor::getBlob(int batchSize)
+{
+    batchSize = std::max(1, batchSize);
+    const int width = inputShape_.width;
+    const int height = inputShape_.height;
+
+    if (batchSize > blobCapacity_ || blobStorage_.empty() ||
+        blobStorage_.size[2] != height || blobStorage_.size[3] != width)
+    {
+        int sizes[] = {batchSize, 3, height, width};
+        blobStorage_.create(4, sizes, CV_32F);
+        blobCapacity_ = batchSize;
+    }
+
+    if (batchSize == blobCapacity_)
+        return blobStorage_;
+
+    int sizes[] = {batchSize, 3, height, width};
+    return cv::Mat(4, sizes, CV_32F, blobStorage_.data);
+}
+
+LetterboxInfo LetterboxPreprocessor::process(const cv::Mat &source, cv::Mat &blob, int batchIndex)
+{
+    const int width = inputShape_.width;
+    const int height = inputShape_.height;
+
+    const cv::Mat *bgr = &source;
+    if (source.channels() == 1)
+    {
+        cv::cvtColor(source, converted_, cv::COLOR_GRAY2BGR);
+        bgr = &converted_;
+    }
+    else if (source.channels() == 4)
+    {
+        cv::cvtColor(source, converted_, cv::COLOR_BGRA2BGR);
+        bgr = &converted_;
+    }
+
+    LetterboxInfo info;
+    info.scale = std::min(width / (float)bgr->cols, height / (float)bgr->rows);
+    int resized_w = std::min(width, static_cast<int>(bgr->cols * info.scale));
+    int resized_h = std::min(height, static_cast<int>(bgr->rows * info.scale));
+    info.pad_x = (width - resized_w) / 2;
+    info.pad_y = (height - resized_h) / 2;
+
+    // cv::resize reuses resized_ as long as the frame geometry does not change
+    cv::resize(*bgr, resized_, cv::Size(resized_w, resized_h));
+
+    float *planeR = blob.ptr<float>(batchIndex, 0);
+    float *planeG = blob.ptr<float>(batchIndex, 1);
+    float *planeB = blob.ptr<float>(batchIndex, 2);
+
+    const float norm = 1.0f / 255.0f;
+    const float pad = padValue_;
+
+    // Single pass: padding, BGR->RGB swap and 1/255 scaling straight into the planes
+    for (int y = 0; y < height; ++y)
+    {
+        float *r = planeR + static_cast<size_t>(y) * width;
+        float *g = planeG + static_cast<size_t>(y) * width;
+        float *b = planeB + static_cast<size_t>(y) * width;
+
+        const int srcY = y - info.pad_y;
+        if (srcY < 0 || srcY >= resized_h)
+        {
+            std::fill(r, r + width, pad);
+            std::fill(g, g + width, pad);
+            std::fill(b, b + width, pad);
+            continue;
+        }
+
+        std::fill(r, r + info.pad_x, pad);
+        std::fill(g, g + info.pad_x, pad);
+        std::fill(b, b + info.pad_x, pad);
+
+        const uchar *src = resized_.ptr<uchar>(srcY);
+        for (int x = 0; x < resized_w; ++x, src += 3)
+        {
+            b[info.pad_x + x] = src[0] * norm;
+            g[info.pad_x + x] = src[1] * norm;
+            r[info.pad_x + x] = src[2] * norm;
+        }
+
+        const int right = info.pad_x + resized_w;
+        std::fill(r + right, r + width, pad);
+        std::fill(g + right, g + width, pad);
+        std::fill(b + right, b + width, pad);
+    }
+
+    return info;
+}
@@ -0,0 +1,49 @@
+#ifndef LETTERBOXPREPROCESSOR_H
+#define LETTERBOXPREPROCESSOR_H
+
+#include <opencv2/opencv.hpp>
+#include "InferenceTypes.h"
+
+/**
+ * @brief Fused letterbox + blob preprocessing into a reusable NCHW float blob
+ *
+ * Replaces formatToSquare + blobFromImage: the frame is resized into a
+ * reusable 8-bit scratch buffer, then a single pass writes it straight into
+ * the blob's planes while swapping BGR->RGB, scaling by 1/255 and filling
+ * the letterbox padding. After the first frame of a given size no heap
+ * allocation happens per call.
+ */
+class LetterboxPreprocessor
+{
+public:
+    explicit LetterboxPreprocessor(const cv::Size &inputShape = {640, 640});
+
+    void setInputShape(const cv::Size &inputShape) { inputShape_ = inputShape; }
+    const cv::Size &getInputShape() const { return inputShape_; }
+
+    /**
+     * @brief Get an NCHW blob header for `batchSize` images
+     *
+     * Storage grows to the largest batch seen and is reused afterwards;
+     * smaller batches get a header over the front of the same buffer.
+     */
+    cv::Mat getBlob(int batchSize);
+
+    /**
+     * @brief Letterbox `source` into entry `batchIndex` of `blob`
+     * @return Pad/scale needed to map model coordinates back to `source`
+     */
+    LetterboxInfo process(const cv::Mat &source, cv::Mat &blob, int batchIndex = 0);
+
+private:
+    cv::Size inputShape_;
+    float padValue_{0.0f};
+
+    cv::Mat blobStorage_;  // (capacity, 3, H, W) float32
+    int blobCapacity_{0};
+
+    cv::Mat resized_;      // Reusable resize target
+    cv::Mat converted_;    // Reusable target for non-BGR inputs
+};
+
+#endif // LETTERBOXPREPROCESSOR_H
@@ -9,6 +9,7 @@
 #include "RegionCountManager.h"
 #include "EventManager.h"
 #include "FullScreenCameraView.h"
+#include "TaskScheduler.h"
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QSettings>
@@ -29,8 +30,6 @@ MainWindow::MainWindow(QWidget* parent)
     loadDisplaySettings();
 
     // Initialize YOLO inference with saved/default model
-    bool runOnGPU = false;
-
     // Check if model file exists
     if (!QFile::exists(currentModelPath_)) {
         std::cerr << "⚠️  Model file not found: " << currentModelPath_.toStdString() << std::endl;
@@ -40,12 +39,14 @@ MainWindow::MainWindow(QWidget* parent)
 
     // Try to load the model
     try {
-        inference_ = std::make_shared<Inference>(
+        inferencePool_ = std::make_shared<InferencePool>(
             currentModelPath_.toStdString(),
             cv::Size(640, 640),
             "classes.txt",
-            runOnGPU
+            backendOptions_,
+            inferencePoolSize_
         );
+        inference_ = inferencePool_->primary();
         std::cout << "✅ Model loaded: " << currentModelPath_.toStdString() << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "❌ Failed to load model: " << e.what() << std::endl;
@@ -54,12 +55,14 @@ MainWindow::MainWindow(QWidget* parent)
         // Fallback to default model
         currentModelPath_ = "yolov8n.onnx";
         try {
-            inference_ = std::make_shared<Inference>(
+            inferencePool_ = std::make_shared<InferencePool>(
                 currentModelPath_.toStdString(),
                 cv::Size(640, 640),
                 "classes.txt",
-                runOnGPU
+                backendOptions_,
+                inferencePoolSize_
             );
+            inference_ = inferencePool_->primary();
             std::cout << "✅ Default model loaded successfully" << std::endl;
         } catch (const std::exception& fallbackError) {
             std::cerr << "❌ FATAL: Cannot load default model: " << fallbackError.what() << std::endl;
@@ -70,6 +73,27 @@ MainWindow::MainWindow(QWidget* parent)
         }
     }
 
+    applyInferenceSettings(*inferencePool_);
+
+    // Pay for lazy graph initialization now rather than on the first camera frame
+    try {
+        inferencePool_->warmUp(warmupPasses_);
+    } catch (const std::exception& e) {
+        std::cerr << "⚠️  Model warm-up failed: " << e.what() << std::endl;
+    }
+
+    modelLoader_ = new ModelLoader(this);
+    connect(modelLoader_, &ModelLoader::modelReady, this, &MainWindow::onModelReady);
+    connect(modelLoader_, &ModelLoader::loadFailed, this, &MainWindow::onModelLoadFailed);
+
+    // One detection service shared by all cameras: forward passes run on its threads (one per pool
+    // instance), never on the pipeline workers. Without batching every frame is a batch of its own.
+    if (batchingEnabled_) {
+        batchEngine_ = std::make_shared<BatchInferenceEngine>(inferencePool_, maxBatchSize_, maxBatchWaitMs_);
+    } else {
+        batchEngine_ = std::make_shared<BatchInferenceEngine>(inferencePool_, 1, 0);
+    }
+
     setupUI();
     setupMenuBar();
     setupToolBar();
@@ -266,7 +290,8 @@ void MainWindow::onAddCamera() {
     auto cameraPtr = cameraManager_->getAllCameras().back();
 
     // [3] Create CameraWidget
-    auto* cameraWidget = new CameraWidget(cameraPtr, inference_, this);
+    auto* cameraWidget = new CameraWidget(cameraPtr, inferencePool_->nextInstance(), this);
+    configureCameraWidget(cameraWidget);
     connect(cameraWidget, &CameraWidget::cameraRemoved,
             this, &MainWindow::onRemoveCamera);
 
@@ -465,7 +490,8 @@ void MainWindow::onLoadConfiguration() {
 
                     if (cameraIndex < cameras.size()) {
                         // Create CameraWidget
-                        auto* cameraWidget = new CameraWidget(cameras[cameraIndex], inference_, this);
+                        auto* cameraWidget = new CameraWidget(cameras[cameraIndex], inferencePool_->nextInstance(), this);
+                        configureCameraWidget(cameraWidget);
                         connect(cameraWidget, &CameraWidget::cameraRemoved,
                                 this, &MainWindow::onRemoveCamera);
                         cameraWidget->setDisplaySize(cameraWidth_, cameraHeight_);
@@ -566,7 +592,8 @@ void MainWindow::loadCamerasToGrid() {
         int cameraId = cameraPtr->getId();
 
         // Create CameraWidget
-        auto* cameraWidget = new CameraWidget(cameraPtr, inference_, this);
+        auto* cameraWidget = new CameraWidget(cameraPtr, inferencePool_->nextInstance(), this);
+        configureCameraWidget(cameraWidget);
 
         // Connect signals
         connect(cameraWidget, &CameraWidget::cameraRemoved,
@@ -601,6 +628,12 @@ void MainWindow::loadCamerasToGrid() {
 }
 
 void MainWindow::onSelectModel() {
+    if (modelLoader_->isLoading()) {
+        QMessageBox::information(this, "Model Loading",
+            "A model is already being loaded. Please wait until it is ready.");
+        return;
+    }
+
     QString filename = QFileDialog::getOpenFileName(
         this,
         "Select YOLOv8 Model",
@@ -609,81 +642,72 @@ void MainWindow::onSelectModel() {
     );
 
     if (!filename.isEmpty()) {
-        try {
-            // Stop all cameras before changing the model
-            bool hadRunningCameras = false;
-
-            // Use cameraWidgetMap_ (new grid system)
-            for (auto& pair : cameraWidgetMap_) {
-                if (pair.second->isRunning()) {
-                    hadRunningCameras = true;
-                    pair.second->stopCapture();
-                }
-            }
-
-            // Create new inference instance with selected model
-            bool runOnGPU = false;
-            auto newInference = std::make_shared<Inference>(
-                filename.toStdString(),
-                cv::Size(640, 640),
-                "classes.txt",
-                runOnGPU
-            );
-
-            // Replace the shared inference instance
-            inference_ = newInference;
-
-            // Update all camera widgets with the new inference
-            for (auto& pair : cameraWidgetMap_) {
-                pair.second->updateInference(inference_);
-            }
-
-            // Save model path to settings
-            currentModelPath_ = filename;
-            QSettings settings("YOLOTracking", "Yolov8CameraGUI");
-            settings.setValue("Model/Path", currentModelPath_);
+        // Load and warm up in the background; cameras keep running on the current model
+        modelLoader_->load(filename, cv::Size(640, 640), "classes.txt", backendOptions_,
+                           inferencePoolSize_, warmupPasses_);
 
-            // Update toolbar label
-            updateModelNameLabel();
+        statusBar()->showMessage(QString("Loading model: %1 ...").arg(filename));
+        std::cout << "⏳ Loading model in background: " << filename.toStdString() << std::endl;
+    }
+}
 
-            // Clear class filter selection since model changed
-            ClassFilterManager::getInstance().clearSelection();
+void MainWindow::onModelReady(std::shared_ptr<InferencePool> pool, const QString& modelPath) {
+    applyInferenceSettings(*pool);
+
+    // Keep the class filter across the swap, minus classes the new model does not have;
+    // the new pool starts without a class mask and would decode every class again
+    ClassFilterManager& classFilter = ClassFilterManager::getInstance();
+    std::set<int> previousSelection = classFilter.getSelectedClasses();
+    std::set<int> selectedClasses;
+    int newClassCount = pool->primary()->getClassCount();
+    for (int classId : previousSelection) {
+        if (newClassCount <= 0 || classId < newClassCount) {
+            selectedClasses.insert(classId);
+        }
+    }
+    if (selectedClasses.size() != previousSelection.size()) {
+        std::cout << "⚠️  Class filter: " << (previousSelection.size() - selectedClasses.size())
+                  << " selected class(es) not in the new model, dropped" << std::endl;
+        classFilter.setSelectedClasses(selectedClasses);
+    }
+    pool->setActiveClasses(selectedClasses);
+
+    // Swap on the GUI thread: pipelines pick it up on their next preprocessed frame,
+    // batch workers on their next batch
+    inferencePool_ = pool;
+    inference_ = inferencePool_->primary();
+    if (batchEngine_) {
+        batchEngine_->setPool(inferencePool_);
+    }
 
-            // Get class count from new model
-            int classCount = inference_->getClassCount();
+    // Update all camera widgets with the new inference, spread over the new pool
+    for (auto& pair : cameraWidgetMap_) {
+        pair.second->updateInference(inferencePool_->nextInstance());
+    }
 
-            QString message = QString(
-                "Model loaded successfully!\n\n"
-                "Model: %1\n"
-                "Classes: %2\n\n"
-                "💡 Tip: Use 'Load Data' to select which classes to detect/count."
-            ).arg(filename).arg(classCount);
+    // Save model path to settings
+    currentModelPath_ = modelPath;
+    QSettings settings("YOLOTracking", "Yolov8CameraGUI");
+    settings.setValue("Model/Path", currentModelPath_);
 
-            QMessageBox::information(this, "Success", message);
-            statusBar()->showMessage(
-                QString("Model loaded: %1 (%2 classes)").arg(filename).arg(classCount), 5000);
+    // Update toolbar label
+    updateModelNameLabel();
 
-            std::cout << "✅ Model changed to: " << currentModelPath_.toStdString() << std::endl;
-            std::cout << "   Model has " << classCount << " classes" << std::endl;
+    // Class list is resolved by the warm-up passes
+    int classCount = inference_->getClassCount();
 
-            // Ask user if they want to restart cameras
-            if (hadRunningCameras) {
-                auto reply = QMessageBox::question(this, "Restart Cameras",
-                    "Do you want to restart the cameras that were running?",
-                    QMessageBox::Yes | QMessageBox::No);
+    statusBar()->showMessage(
+        QString("Model loaded: %1 (%2 classes)").arg(modelPath).arg(classCount), 5000);
 
-                if (reply == QMessageBox::Yes) {
-                    onStartAll();
-                }
-            }
+    std::cout << "✅ Model changed to: " << currentModelPath_.toStdString() << std::endl;
+    std::cout << "   Model has " << classCount << " classes" << std::endl;
+}
 
-        } catch (const std::exception& e) {
-            QMessageBox::critical(this, "Error",
-                QString("Failed to load model!\n\nError: %1").arg(e.what()));
-            statusBar()->showMessage("Failed to load model", 3000);
-            std::cerr << "❌ Failed to load model: " << e.what() << std::endl;
-        }
-    }
+void MainWindow::onModelLoadFailed(const QString& modelPath, const QString& error) {
+    QMessageBox::critical(this, "Error",
+        QString("Failed to load model!\n\nModel: %1\nError: %2").arg(modelPath).arg(error));
+    statusBar()->showMessage("Failed to load model", 3000);
+    std::cerr << "❌ Failed to load model: " << error.toStdString() << std::endl;
 }
 
 void MainWindow::updateCameraGrid() {
@@ -710,7 +734,8 @@ void MainWindow::updateCameraGrid() {
 
             if (cameraIndex < cameras.size()) {
                 // Create CameraWidget
-                auto* cameraWidget = new CameraWidget(cameras[cameraIndex], inference_, this);
+                auto* cameraWidget = new CameraWidget(cameras[cameraIndex], inferencePool_->nextInstance(), this);
+                configureCameraWidget(cameraWidget);
                 connect(cameraWidget, &CameraWidget::cameraRemoved,
                         this, &MainWindow::onRemoveCamera);
                 cameraWidget->setDisplaySize(cameraWidth_, cameraHeight_);
@@ -775,6 +800,63 @@ void MainWindow::loadDisplaySettings() {
 
     // Load model path (default: yolov8n.onnx)
     currentModelPath_ = settings.value("Model/Path", "yolov8n.onnx").toString();
+
+    // Cross-camera batching (one forward pass for the latest frame of every camera)
+    batchingEnabled_ = settings.value("Inference/BatchingEnabled", true).toBool();
+    maxBatchSize_ = settings.value("Inference/MaxBatchSize", 16).toInt();
+    maxBatchWaitMs_ = settings.value("Inference/MaxBatchWaitMs", 10).toInt();
+
+    // Independent Net instances, one forward pass each at a time (0 = derive from core count).
+    // Applies with or without batching: cameras detect in parallel on different instances.
+    inferencePoolSize_ = settings.value("Inference/PoolSize", 0).toInt();
+
+    // Detector runtime: "opencv" (OpenCV DNN) or "onnxruntime" (needs a USE_ONNXRUNTIME build)
+    backendOptions_.type = backendTypeFromString(
+        settings.value("Inference/Backend", "opencv").toString().toStdString());
+    backendOptions_.useCuda = false;
+    backendOptions_.intraOpThreads = settings.value("Inference/IntraOpThreads", 0).toInt();
+    backendOptions_.interOpThreads = settings.value("Inference/InterOpThreads", 0).toInt();
+
+    // Per-frame detection cap applied after NMS (0 = unlimited)
+    maxDetections_ = settings.value("Inference/MaxDetections", 0).toInt();
+
+    // Tiled detection for high-resolution cameras (tiles are batched into one forward pass)
+    tilingConfig_.enabled = settings.value("Inference/TilingEnabled", false).toBool();
+    tilingConfig_.tileSize = settings.value("Inference/TileSize", 960).toInt();
+    tilingConfig_.overlap = settings.value("Inference/TileOverlap", 0.2).toFloat();
+    tilingConfig_.includeFullFrame = settings.value("Inference/TileFullFrame", true).toBool();
+
+    // Blank-frame forward passes run before a model is used (startup and model change)
+    warmupPasses_ = settings.value("Inference/WarmupPasses", 2).toInt();
+
+    // Run the detector only on the area around a camera's regions (margin relative to that area)
+    roiInferenceEnabled_ = settings.value("Inference/RoiEnabled", false).toBool();
+    roiMarginRatio_ = settings.value("Inference/RoiMargin", 0.15).toFloat();
+
+    // Detect every K frames (K adapts between the bounds) and extrapolate tracks in between
+    scheduleConfig_.enabled = settings.value("Inference/ScheduleEnabled", false).toBool();
+    scheduleConfig_.minInterval = settings.value("Inference/MinDetectInterval", 1).toInt();
+    scheduleConfig_.maxInterval = settings.value("Inference/MaxDetectInterval", 4).toInt();
+
+    // Skip detection on static scenes (motion inside regions only, if a camera has any)
+    motionGateConfig_.enabled = settings.value("Inference/MotionGateEnabled", false).toBool();
+    motionGateConfig_.minChangedRatio = settings.value("Inference/MotionMinChangedRatio", 0.002).toDouble();
+    motionGateConfig_.forceInterval = settings.value("Inference/MotionForceInterval", 30).toInt();
+}
+
+void MainWindow::configureCameraWidget(CameraWidget* widget) {
+    widget->setBatchInferenceEngine(batchEngine_);
+    widget->setRoiInference(roiInferenceEnabled_, roiMarginRatio_);
+    widget->setDetectionSchedule(scheduleConfig_);
+    widget->setMotionGate(motionGateConfig_);
+}
+
+void MainWindow::applyInferenceSettings(InferencePool& pool) {
+    pool.setMaxDetections(maxDetections_);
+    pool.setTiling(tilingConfig_);
+
+    // Each instance can run a forward pass at once; split the cores the pipeline workers leave free
+    TaskScheduler::coordinateOpenCvThreads(pool.size());
 }
 
 void MainWindow::updateModelNameLabel() {
@@ -847,6 +929,11 @@ void MainWindow::onLoadData() {
         std::set<int> selectedClasses = dialog.getSelectedClasses();
         ClassFilterManager::getInstance().setSelectedClasses(selectedClasses);
 
+        // Let the decoder skip unselected class channels entirely
+        if (inferencePool_) {
+            inferencePool_->setActiveClasses(selectedClasses);
+        }
+
         // Update status bar
         if (dialog.isCountAllMode()) {
             statusBar()->showMessage("Class filter: Counting ALL classes", 5000);
@@ -882,8 +969,13 @@ void MainWindow::onFullScreenRequested(int cameraId) {
         return;
     }
 
+    // The view shows the camera pipeline's annotated output, so the pipeline has to be running
+    if (!it->second->isRunning()) {
+        it->second->startCapture();
+    }
+
     // Create and show full screen view
-    FullScreenCameraView* fullScreenView = new FullScreenCameraView(cameraPtr, inference_, this);
+    FullScreenCameraView* fullScreenView = new FullScreenCameraView(cameraPtr, this);
     fullScreenView->exec();
     delete fullScreenView;
 
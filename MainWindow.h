@@ -15,6 +15,9 @@
 #include "CameraManager.h"
 #include "CameraWidget.h"
 #include "inference.h"
+#include "BatchInferenceEngine.h"
+#include "InferencePool.h"
+#include "ModelLoader.h"
 #include "GridManager.h"
 #include "CameraGridWidget.h"
 #include "CropsPanelWidget.h"
@@ -35,6 +38,8 @@ private slots:
     void onStopAll();
     void onAbout();
     void onSelectModel();
+    void onModelReady(std::shared_ptr<InferencePool> pool, const QString& modelPath);
+    void onModelLoadFailed(const QString& modelPath, const QString& error);
     void onEvents();
     void onDisplaySettings();
     void onTelegramSettings();
@@ -49,6 +54,8 @@ private:
     void updateCameraGrid();  // DEPRECATED: Kept for backward compatibility
     void clearCameraGrid();   // DEPRECATED: Kept for backward compatibility
     void loadDisplaySettings();
+    void applyInferenceSettings(InferencePool& pool);  // Per-instance options from QSettings
+    void configureCameraWidget(CameraWidget* widget);  // Per-camera options from QSettings
     void applyDisplaySettings();
     QWidget* createPlaceholderWidget();
 
@@ -62,7 +69,10 @@ private:
                         int trackId, float confidence);
 
     std::unique_ptr<CameraManager> cameraManager_;
-    std::shared_ptr<Inference> inference_;
+    std::shared_ptr<InferencePool> inferencePool_;     // K Net instances sharing one model load
+    std::shared_ptr<Inference> inference_;             // Primary pool instance (class names, model metadata)
+    std::shared_ptr<BatchInferenceEngine> batchEngine_;  // Detection for every camera (batched if enabled)
+    ModelLoader* modelLoader_;                         // Background load + warm-up for model changes
     std::unique_ptr<GridManager> gridManager_;  // DEPRECATED: Old grid manager
     std::map<int, CameraWidget*> cameraWidgetMap_;  // ID -> Widget mapping
 
@@ -96,6 +106,20 @@ private:
     int gridRows_;
     int gridColumns_;
 
+    // Inference batching settings
+    bool batchingEnabled_;
+    int maxBatchSize_;
+    int maxBatchWaitMs_;
+    int inferencePoolSize_;
+    int maxDetections_;
+    BackendOptions backendOptions_;
+    TilingConfig tilingConfig_;
+    int warmupPasses_;
+    bool roiInferenceEnabled_;
+    float roiMarginRatio_;
+    DetectionScheduler::Config scheduleConfig_;
+    MotionGate::Config motionGateConfig_;
+
     // Model management
     QString currentModelPath_;
     QLabel* modelNameLabel_;
@@ -0,0 +1,67 @@
+#include "ModelLoader.h"
+#include <QMetaObject>
+#include <chrono>
+#include <iostream>
+
+ModelLoader::ModelLoader(QObject* parent)
+    : QObject(parent) {
+}
+
+ModelLoader::~ModelLoader() {
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+bool ModelLoader::load(const QString& modelPath,
+                       const cv::Size& modelInputShape,
+                       const std::string& classesTxtFile,
+                       const BackendOptions& backendOptions,
+                       int poolSize,
+                       int warmupPasses) {
+    if (loading_.exchange(true)) {
+        return false;
+    }
+
+    // The previous load has already published its result
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    worker_ = std::thread([this, modelPath, modelInputShape, classesTxtFile, backendOptions, poolSize, warmupPasses]() {
+        auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<InferencePool> pool;
+        QString error;
+
+        try {
+            pool = std::make_shared<InferencePool>(
+                modelPath.toStdString(), modelInputShape, classesTxtFile, backendOptions, poolSize);
+            pool->warmUp(warmupPasses);
+        } catch (const std::exception& e) {
+            pool.reset();
+            error = QString::fromStdString(e.what());
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        if (pool) {
+            std::cout << "✅ Model ready in background: " << modelPath.toStdString()
+                      << " (" << elapsed.count() << " ms)" << std::endl;
+        } else {
+            std::cerr << "❌ Background model load failed: " << error.toStdString() << std::endl;
+        }
+
+        // Hand the result to the GUI thread; the swap happens there, between frames
+        QMetaObject::invokeMethod(this, [this, pool, modelPath, error]() {
+            loading_ = false;
+            if (pool) {
+                emit modelReady(pool, modelPath);
+            } else {
+                emit loadFailed(modelPath, error);
+            }
+        }, Qt::QueuedConnection);
+    });
+
+    return true;
+}
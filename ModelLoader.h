@@ -0,0 +1,60 @@
+#ifndef MODELLOADER_H
+#define MODELLOADER_H
+
+#include <QObject>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <opencv2/core.hpp>
+
+#include "InferencePool.h"
+
+/**
+ * @brief Loads and warms up a model on a background thread
+ *
+ * Reading the ONNX file, building the pool's Net instances, loading the
+ * class list and the warm-up forward passes all happen off the GUI thread.
+ * When the pool is ready, modelReady is emitted on the loader's (GUI)
+ * thread, and the caller swaps it in between frames. Cameras keep running
+ * on the previous model until then.
+ */
+class ModelLoader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ModelLoader(QObject* parent = nullptr);
+    ~ModelLoader() override;
+
+    /**
+     * @brief Start loading a model in the background
+     * @param warmupPasses Forward passes per instance before the pool is published
+     * @return false if a load is already in progress
+     */
+    bool load(const QString& modelPath,
+              const cv::Size& modelInputShape,
+              const std::string& classesTxtFile,
+              const BackendOptions& backendOptions,
+              int poolSize,
+              int warmupPasses);
+
+    bool isLoading() const { return loading_.load(); }
+
+signals:
+    /**
+     * @brief Emitted when the pool is loaded and warmed up
+     */
+    void modelReady(std::shared_ptr<InferencePool> pool, const QString& modelPath);
+
+    /**
+     * @brief Emitted when the model cannot be loaded
+     */
+    void loadFailed(const QString& modelPath, const QString& error);
+
+private:
+    std::thread worker_;
+    std::atomic<bool> loading_{false};
+};
+
+#endif // MODELLOADER_H
@@ -0,0 +1,85 @@
+#include "MotionGate.h"
+#include <algorithm>
+
+void MotionGate::setConfig(const Config& config) {
+    config_ = config;
+    config_.analysisWidth = std::max(16, config_.analysisWidth);
+    config_.forceInterval = std::max(1, config_.forceInterval);
+    reset();
+}
+
+bool MotionGate::shouldInfer(const cv::Mat& frame, const std::vector<Region>& regions, bool hasActiveTracks) {
+    bool infer = true;
+    if (config_.enabled && !frame.empty()) {
+        // Always keep the reference frame current, even when the result is overridden
+        bool motion = detectMotion(frame, regions);
+        infer = motion || hasActiveTracks || framesSinceInference_ + 1 >= config_.forceInterval;
+    }
+
+    if (infer) {
+        framesSinceInference_ = 0;
+        ++inferredFrames_;
+    } else {
+        ++framesSinceInference_;
+        ++skippedFrames_;
+    }
+    return infer;
+}
+
+void MotionGate::reset() {
+    previous_.release();
+    framesSinceInference_ = 0;
+}
+
+bool MotionGate::detectMotion(const cv::Mat& frame, const std::vector<Region>& regions) {
+    const double scale = static_cast<double>(config_.analysisWidth) / frame.cols;
+    const cv::Size analysisSize(config_.analysisWidth, std::max(1, static_cast<int>(frame.rows * scale)));
+
+    cv::Mat small;
+    cv::resize(frame, small, analysisSize, 0, 0, cv::INTER_AREA);
+    if (small.channels() == 3) {
+        cv::cvtColor(small, current_, cv::COLOR_BGR2GRAY);
+    } else if (small.channels() == 4) {
+        cv::cvtColor(small, current_, cv::COLOR_BGRA2GRAY);
+    } else {
+        current_ = small;
+    }
+    cv::GaussianBlur(current_, current_, cv::Size(5, 5), 0);
+
+    // First frame, or the camera resolution changed: nothing to compare with
+    if (previous_.empty() || previous_.size() != current_.size()) {
+        current_.copyTo(previous_);
+        return true;
+    }
+
+    cv::absdiff(current_, previous_, diff_);
+    cv::threshold(diff_, diff_, config_.pixelThreshold, 255, cv::THRESH_BINARY);
+    std::swap(previous_, current_);
+
+    int consideredPixels = diff_.rows * diff_.cols;
+    if (!regions.empty()) {
+        // Regions are in source-frame coordinates
+        mask_ = cv::Mat::zeros(diff_.size(), CV_8UC1);
+        for (const auto& region : regions) {
+            std::vector<cv::Point> scaled;
+            scaled.reserve(region.getPoints().size());
+            for (const auto& pt : region.getPoints()) {
+                scaled.emplace_back(static_cast<int>(pt.x * scale), static_cast<int>(pt.y * scale));
+            }
+            if (scaled.size() >= 3) {
+                std::vector<std::vector<cv::Point>> polygon{scaled};
+                cv::fillPoly(mask_, polygon, cv::Scalar(255));
+            }
+        }
+
+        consideredPixels = cv::countNonZero(mask_);
+        if (consideredPixels > 0) {
+            cv::bitwise_and(diff_, mask_, diff_);
+        } else {
+            consideredPixels = diff_.rows * diff_.cols;  // Degenerate regions: use the whole frame
+        }
+    }
+
+    const int changed = cv::countNonZero(diff_);
+    return changed >= std::max(1.0, config_.minChangedRatio * consideredPixels);
+}
@@ -0,0 +1,65 @@
+#ifndef MOTIONGATE_H
+#define MOTIONGATE_H
+
+#include <cstdint>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "Region.h"
+
+/**
+ * @brief Cheap frame-differencing gate in front of the detector
+ *
+ * Each frame is downscaled to a small grayscale image and compared with the
+ * previous one. If the fraction of changed pixels stays below a threshold,
+ * the detector is skipped. When regions are given, only pixels inside the
+ * region polygons are considered. A detection is still forced every
+ * forceInterval frames as a safety net (e.g. for objects that stopped moving).
+ */
+class MotionGate {
+public:
+    struct Config {
+        bool enabled = false;
+        int analysisWidth = 160;          // Width of the downscaled difference image
+        int pixelThreshold = 25;          // Gray-level change that counts as motion
+        double minChangedRatio = 0.002;   // Fraction of (masked) pixels that must change
+        int forceInterval = 30;           // Run the detector at least every N frames
+    };
+
+    MotionGate() = default;
+    explicit MotionGate(const Config& config) : config_(config) {}
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief Decide whether the detector should run on this frame
+     * @param regions If not empty, only motion inside these polygons counts
+     * @param hasActiveTracks Never skip while objects are tracked; a person standing
+     *        still produces no motion but must keep being detected
+     * @return true to run inference; false if the scene is unchanged
+     *
+     * Updates the skipped/inferred counters.
+     */
+    bool shouldInfer(const cv::Mat& frame, const std::vector<Region>& regions, bool hasActiveTracks);
+
+    uint64_t getInferredFrames() const { return inferredFrames_; }
+    uint64_t getSkippedFrames() const { return skippedFrames_; }
+
+    // Forget the reference frame (next call always infers); counters are kept
+    void reset();
+
+private:
+    bool detectMotion(const cv::Mat& frame, const std::vector<Region>& regions);
+
+    Config config_;
+    cv::Mat previous_;
+    cv::Mat current_;
+    cv::Mat diff_;
+    cv::Mat mask_;
+    int framesSinceInference_ = 0;
+    uint64_t inferredFrames_ = 0;
+    uint64_t skippedFrames_ = 0;
+};
+
+#endif // MOTIONGATE_H
@@ -0,0 +1,177 @@
+#include "Nms.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+namespace {
+
+// Upper bound on grid cells per group; very spread-out boxes get coarser cells instead
+constexpr int64_t kMaxCells = 4096;
+
+// Scratch buffers reused across calls; one set per thread so concurrent decodes do not share them
+struct NmsWorkspace
+{
+    std::vector<int> order;
+    std::vector<std::vector<int>> cells;
+    std::vector<int> touched;
+    std::vector<int> visited;
+};
+
+thread_local NmsWorkspace workspace;
+
+// IoU is the same measure as cv::dnn::NMSBoxes for cv::Rect (1 - jaccardDistance);
+// IoS (intersection over the smaller box) catches a clipped box lying inside a full one
+inline bool overlaps(const cv::Rect &a, const cv::Rect &b, float iouThreshold, float iosThreshold)
+{
+    const int areaA = a.area();
+    const int areaB = b.area();
+    if (areaA + areaB <= 0)
+        return false;
+
+    const int intersection = (a & b).area();
+    if (static_cast<float>(intersection) / static_cast<float>(areaA + areaB - intersection) > iouThreshold)
+        return true;
+
+    const int smaller = std::min(areaA, areaB);
+    return iosThreshold > 0.0f && smaller > 0 &&
+           static_cast<float>(intersection) / static_cast<float>(smaller) > iosThreshold;
+}
+
+// Greedy suppression over order[begin, end), already sorted by descending score
+void suppressGroup(const std::vector<cv::Rect> &boxes, const int *begin, const int *end,
+                   float iouThreshold, float iosThreshold, NmsWorkspace &ws, std::vector<int> &keep)
+{
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    int64_t sideSum = 0;
+    for (const int *p = begin; p != end; ++p)
+    {
+        const cv::Rect &box = boxes[*p];
+        minX = std::min(minX, box.x);
+        minY = std::min(minY, box.y);
+        maxX = std::max(maxX, box.x + std::max(box.width, 0));
+        maxY = std::max(maxY, box.y + std::max(box.height, 0));
+        sideSum += std::max(box.width, box.height);
+    }
+
+    // Cells about the size of a typical box keep the number of cells per box small
+    const int64_t count = end - begin;
+    int cell = static_cast<int>(std::clamp<int64_t>(sideSum / count, 16, 1024));
+    int cols = 0, rows = 0;
+    for (;;)
+    {
+        cols = (maxX - minX) / cell + 1;
+        rows = (maxY - minY) / cell + 1;
+        if (static_cast<int64_t>(cols) * rows <= kMaxCells)
+            break;
+        cell *= 2;
+    }
+
+    if (ws.cells.size() < static_cast<size_t>(cols * rows))
+        ws.cells.resize(cols * rows);
+
+    for (const int *p = begin; p != end; ++p)
+    {
+        const int idx = *p;
+        const cv::Rect &box = boxes[idx];
+        const int x0 = (box.x - minX) / cell;
+        const int y0 = (box.y - minY) / cell;
+        const int x1 = std::min(cols - 1, (box.x + std::max(box.width, 0) - minX) / cell);
+        const int y1 = std::min(rows - 1, (box.y + std::max(box.height, 0) - minY) / cell);
+
+        // Any kept box that intersects this one shares at least one cell with it
+        bool suppressed = false;
+        for (int cy = y0; cy <= y1 && !suppressed; ++cy)
+        {
+            for (int cx = x0; cx <= x1 && !suppressed; ++cx)
+            {
+                for (int k : ws.cells[cy * cols + cx])
+                {
+                    if (ws.visited[k] == idx)
+                        continue;  // Already compared through another cell
+                    ws.visited[k] = idx;
+
+                    if (overlaps(box, boxes[k], iouThreshold, iosThreshold))
+                    {
+                        suppressed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (suppressed)
+            continue;
+
+        keep.push_back(idx);
+        for (int cy = y0; cy <= y1; ++cy)
+        {
+            for (int cx = x0; cx <= x1; ++cx)
+            {
+                std::vector<int> &bucket = ws.cells[cy * cols + cx];
+                if (bucket.empty())
+                    ws.touched.push_back(cy * cols + cx);
+                bucket.push_back(idx);
+            }
+        }
+    }
+
+    for (int c : ws.touched)
+        ws.cells[c].clear();
+    ws.touched.clear();
+}
+
+} // namespace
+
+void nonMaxSuppression(const DecodedCandidates &candidates, const NmsParams &params, std::vector<int> &keep)
+{
+    keep.clear();
+
+    const std::vector<float> &scores = candidates.confidences;
+    const std::vector<int> &classIds = candidates.class_ids;
+    const int count = static_cast<int>(scores.size());
+    if (count == 0)
+        return;
+
+    NmsWorkspace &ws = workspace;
+    ws.order.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        if (scores[i] > params.scoreThreshold)
+            ws.order.push_back(i);
+    }
+    ws.visited.assign(count, -1);
+
+    // Class-aware: group by class, then by score inside each class
+    auto byScore = [&scores](int a, int b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+    };
+    if (params.classAware)
+    {
+        std::sort(ws.order.begin(), ws.order.end(), [&](int a, int b) {
+            return classIds[a] != classIds[b] ? classIds[a] < classIds[b] : byScore(a, b);
+        });
+    }
+    else
+    {
+        std::sort(ws.order.begin(), ws.order.end(), byScore);
+    }
+
+    const int *first = ws.order.data();
+    const int *last = first + ws.order.size();
+    while (first != last)
+    {
+        const int *groupEnd = last;
+        if (params.classAware)
+        {
+            const int classId = classIds[*first];
+            groupEnd = std::find_if(first, last, [&](int i) { return classIds[i] != classId; });
+        }
+
+        suppressGroup(candidates.boxes, first, groupEnd, params.iouThreshold, params.iosThreshold, ws, keep);
+        first = groupEnd;
+    }
+
+    std::sort(keep.begin(), keep.end(), byScore);
+    if (params.topK > 0 && static_cast<int>(keep.size()) > params.topK)
+        keep.resize(params.topK);
+}
@@ -0,0 +1,35 @@
+#ifndef NMS_H
+#define NMS_H
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include "YoloDecoder.h"
+
+struct NmsParams
+{
+    float scoreThreshold{0.0f};  // Candidates at or below this score are dropped
+    float iouThreshold{0.5f};    // Suppress boxes overlapping a kept box by more than this
+    bool classAware{true};       // Only boxes of the same class suppress each other
+    int topK{0};                 // Keep at most this many boxes (0 = no cap)
+    float iosThreshold{0.0f};    // Also suppress when the intersection covers more than this
+                                 // fraction of the smaller box (0 = off); merges clipped duplicates
+};
+
+/**
+ * @brief Greedy non-maximum suppression over decoded candidates
+ *
+ * Drop-in replacement for cv::dnn::NMSBoxes (same IoU definition) that
+ * scales to thousands of candidates:
+ *  - class-aware mode suppresses per class, as if every class were shifted
+ *    into its own coordinate range (batched-offset NMS), so overlapping
+ *    objects of different classes survive
+ *  - kept boxes are registered in a uniform grid, and each candidate is only
+ *    compared with kept boxes sharing one of its cells
+ *
+ * @param candidates Boxes, scores and class ids from YoloDecoder
+ * @param params Thresholds and options
+ * @param keep Output: indices into candidates, highest score first
+ */
+void nonMaxSuppression(const DecodedCandidates &candidates, const NmsParams &params, std::vector<int> &keep);
+
+#endif // NMS_H
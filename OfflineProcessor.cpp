@@ -0,0 +1,272 @@
+#include "OfflineProcessor.h"
+#include "RegionTracker.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// File name tags as EventManager writes them
+const char* eventTypeName(EventType type) {
+    switch (type) {
+        case EventType::FIRST_ENTRY: return "ENTRY";
+        case EventType::PERIODIC: return "PERIODIC";
+        case EventType::EXIT: return "EXIT";
+    }
+    return "UNKNOWN";
+}
+
+// Directory names as EventManager builds them
+QString directoryName(const std::string& name) {
+    QString dir = QString::fromStdString(name);
+    dir.replace(" ", "_");
+    return dir;
+}
+
+// Recorders close the file at the end of the recording, so without a birth time
+// the start is the modification time minus the stream duration
+QDateTime recordingStart(const std::string& path, double durationMs) {
+    QFileInfo info(QString::fromStdString(path));
+    QDateTime birth = info.birthTime();
+    if (birth.isValid()) {
+        return birth;
+    }
+    return info.lastModified().addMSecs(-static_cast<qint64>(durationMs));
+}
+
+}  // namespace
+
+OfflineProcessor::OfflineProcessor(std::shared_ptr<InferencePool> pool, const Options& options)
+    : pool_(std::move(pool)), options_(options) {
+}
+
+std::vector<OfflineProcessor::Result> OfflineProcessor::run(const std::vector<Job>& jobs) {
+    std::vector<Result> results(jobs.size());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < jobs.size(); i = next++) {
+            try {
+                results[i] = processFile(jobs[i]);
+            } catch (const std::exception& e) {
+                results[i].videoPath = jobs[i].videoPath;
+                results[i].cameraName = jobs[i].cameraName;
+                results[i].error = e.what();
+            }
+        }
+    };
+
+    size_t workerCount = std::min(jobs.size(), static_cast<size_t>(std::max(1, options_.jobs)));
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return results;
+}
+
+OfflineProcessor::Result OfflineProcessor::processFile(const Job& job) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    Result result;
+    result.videoPath = job.videoPath;
+    result.cameraName = job.cameraName;
+
+    cv::VideoCapture capture(job.videoPath, cv::CAP_FFMPEG);
+    if (!capture.isOpened()) {
+        result.error = "cannot open video file";
+        return result;
+    }
+
+    double fps = capture.get(cv::CAP_PROP_FPS);
+    double frameCount = capture.get(cv::CAP_PROP_FRAME_COUNT);
+    double durationMs = (fps > 0.0 && frameCount > 0.0) ? frameCount / fps * 1000.0 : 0.0;
+    const QDateTime origin = recordingStart(job.videoPath, durationMs);
+
+    QDir outputDir(QString::fromStdString(options_.outputDir));
+    const QString cameraDir = outputDir.filePath(directoryName(job.cameraName));
+    QDir().mkpath(cameraDir);
+
+    std::cout << "🎞️  Offline: " << job.cameraName << " (" << job.videoPath << "), recording started "
+              << origin.toString("yyyy-MM-dd HH:mm:ss").toStdString() << std::endl;
+
+    // Same class/region filter, tracker and event rules as the live pipeline
+    int frameRate = (fps > 0.0 && fps <= 240.0) ? static_cast<int>(fps + 0.5) : 30;
+    RegionTracker regionTracker(frameRate);
+
+    InferencePool::Lease inference = pool_->acquire();
+
+    json events = json::array();
+
+    cv::Mat frame;
+    std::vector<Detection> detections;
+    std::vector<Region> regions;  // job.regions mapped to the file's frame size
+    int frameNumber = 0;
+    double ptsMs = 0.0;
+
+    // Same fields as DetectionEvent::toJson, plus the stream time; timestamps come from the recording, not the clock
+    auto recordEvent = [&](const RegionTracker::Event& trackEvent) {
+        size_t trackId = trackEvent.trackId;
+        const std::string& regionName = trackEvent.regionName;
+        const cv::Rect& box = trackEvent.box;
+        EventType type = trackEvent.type;
+
+        int padding = 15;
+        cv::Rect padded(box.x - padding, box.y - padding, box.width + 2 * padding, box.height + 2 * padding);
+        padded &= cv::Rect(0, 0, frame.cols, frame.rows);
+        if (padded.area() <= 0) {
+            return;
+        }
+
+        QDateTime timestamp = origin.addMSecs(static_cast<qint64>(ptsMs));
+        QString regionDir = QDir(cameraDir).filePath(directoryName(regionName));
+        QDir().mkpath(regionDir);
+
+        std::ostringstream filename;
+        filename << trackId << "_" << timestamp.toString("HHmmss").toStdString() << "_" << eventTypeName(type) << ".jpg";
+        std::string imagePath = QDir(regionDir).filePath(QString::fromStdString(filename.str())).toStdString();
+        if (!cv::imwrite(imagePath, frame(padded))) {
+            std::cerr << "Error saving event image: " << imagePath << std::endl;
+            return;
+        }
+
+        int classId = regionTracker.getTrackClass(trackId);
+        json event;
+        event["track_id"] = trackId;
+        event["camera_id"] = job.cameraId;
+        event["camera_name"] = job.cameraName;
+        event["region_name"] = regionName;
+        event["object_class"] = classId >= 0 ? inference->getClassName(classId) : "unknown";
+        event["confidence"] = trackEvent.score;
+        event["event_type"] = eventTypeName(type);
+        event["timestamp"] = timestamp.toString("yyyy-MM-dd HH:mm:ss").toStdString();
+        event["stream_time_ms"] = static_cast<int64_t>(ptsMs);
+        event["frame_number"] = frameNumber;
+        event["image_path"] = imagePath;
+        event["bbox"] = {
+            {"x", box.x},
+            {"y", box.y},
+            {"width", box.width},
+            {"height", box.height}
+        };
+        events.push_back(event);
+    };
+
+    while (capture.read(frame) && !frame.empty()) {
+        ++frameNumber;
+        ptsMs = capture.get(cv::CAP_PROP_POS_MSEC);
+
+        if (frameNumber == 1) {
+            // Regions were drawn on the live stream, which may not match the recording's size
+            for (const Region& region : job.regions) {
+                regions.push_back(region.scaledTo(frame.size()));
+            }
+        }
+
+        cv::Rect roi(0, 0, frame.cols, frame.rows);
+        if (options_.roiInference) {
+            cv::Rect combined = Region::getCombinedRoi(regions, frame.size(), options_.roiMarginRatio);
+            if (combined.area() > 0) {
+                roi = combined;
+            }
+        }
+        inference->runInference(frame(roi), detections);
+        for (Detection& det : detections) {
+            det.box.x += roi.x;
+            det.box.y += roi.y;
+        }
+
+        std::vector<TrackedBox> tracks = regionTracker.track(detections, options_.countClasses, regions);
+        RegionTracker::RegionUpdate update =
+            regionTracker.updateRegions(tracks, regions, frameNumber, options_.periodicCaptureInterval);
+        for (const RegionTracker::Event& event : update.events) {
+            recordEvent(event);
+        }
+    }
+
+    // metadata.json is what EventManager::loadEventsFromDirectory picks up
+    json metadata;
+    metadata["events"] = events;
+    std::ofstream metadataFile(QDir(cameraDir).filePath("metadata.json").toStdString());
+    metadataFile << metadata.dump(4);
+
+    json counts = json::object();
+    for (const auto& entry : regionTracker.getRegionObjectIds()) {
+        counts[entry.first] = {
+            {"count", entry.second.size()},
+            {"ids", entry.second}
+        };
+        result.regionCounts[entry.first] = static_cast<int>(entry.second.size());
+    }
+    std::ofstream countsFile(QDir(cameraDir).filePath("region_count.json").toStdString());
+    countsFile << counts.dump(4);
+
+    result.ok = true;
+    result.frames = static_cast<uint64_t>(frameNumber);
+    result.videoSeconds = ptsMs > 0.0 ? ptsMs / 1000.0 : (fps > 0.0 ? frameNumber / fps : 0.0);
+    result.processingSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.events = events.size();
+
+    std::cout << "✅ Offline: " << job.cameraName << " done, " << result.frames << " frames, "
+              << result.events << " event(s) in " << std::fixed << std::setprecision(1)
+              << result.processingSeconds << " s" << std::endl;
+    return result;
+}
+
+void OfflineProcessor::printSummary(const std::vector<Result>& results, double wallSeconds) {
+    uint64_t totalFrames = 0;
+    double totalVideoSeconds = 0.0;
+    size_t totalEvents = 0;
+    size_t failed = 0;
+
+    std::cout << "\n📊 Offline throughput (" << results.size() << " file(s))" << std::endl;
+    std::cout << std::fixed;
+    for (const Result& result : results) {
+        if (!result.ok) {
+            ++failed;
+            std::cout << "  ❌ " << result.cameraName << ": " << result.error << std::endl;
+            continue;
+        }
+
+        double fps = result.processingSeconds > 0.0 ? result.frames / result.processingSeconds : 0.0;
+        double speed = result.processingSeconds > 0.0 ? result.videoSeconds / result.processingSeconds : 0.0;
+        std::cout << "  " << std::left << std::setw(24) << result.cameraName << std::right
+                  << std::setw(9) << result.frames << " frames"
+                  << std::setprecision(1) << std::setw(9) << result.videoSeconds << " s video"
+                  << std::setw(8) << result.processingSeconds << " s"
+                  << std::setw(8) << fps << " fps"
+                  << "  x" << std::setprecision(2) << speed << " realtime"
+                  << std::setw(6) << result.events << " event(s)" << std::endl;
+        for (const auto& count : result.regionCounts) {
+            std::cout << "      " << count.first << ": " << count.second << std::endl;
+        }
+
+        totalFrames += result.frames;
+        totalVideoSeconds += result.videoSeconds;
+        totalEvents += result.events;
+    }
+
+    double fps = wallSeconds > 0.0 ? totalFrames / wallSeconds : 0.0;
+    double speed = wallSeconds > 0.0 ? totalVideoSeconds / wallSeconds : 0.0;
+    std::cout << "  total: " << totalFrames << " frames, " << std::setprecision(1) << totalVideoSeconds
+              << " s of video in " << wallSeconds << " s (" << fps << " fps, x" << std::setprecision(2)
+              << speed << " realtime), " << totalEvents << " event(s)";
+    if (failed > 0) {
+        std::cout << ", " << failed << " file(s) failed";
+    }
+    std::cout << std::endl;
+}
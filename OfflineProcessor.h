@@ -0,0 +1,74 @@
+#ifndef OFFLINEPROCESSOR_H
+#define OFFLINEPROCESSOR_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "InferencePool.h"
+#include "Region.h"
+
+/**
+ * @brief Faster-than-realtime counting for recorded video files
+ *
+ * Counts with the live pipeline's RegionTracker (class filter, region filter,
+ * ByteTrack, entry / periodic / exit events, unique IDs per region) over whole files,
+ * reading frames as fast as decoding and inference allow instead of on the
+ * GUI timer. Event timestamps are the recording start plus the frame PTS,
+ * never the wall clock.
+ *
+ * Files run in parallel, one worker thread and one pooled Inference
+ * instance each. Every file gets its own output directory:
+ *   <outputDir>/<camera>/<region>/<track>_<HHmmss>_<TYPE>.jpg
+ *   <outputDir>/<camera>/metadata.json       (EventManager format)
+ *   <outputDir>/<camera>/region_count.json   (RegionCountManager format)
+ */
+class OfflineProcessor {
+public:
+    struct Job {
+        std::string videoPath;
+        std::string cameraName;  // Names the output directory and the events (default: file name)
+        int cameraId = 0;
+        std::vector<Region> regions;
+    };
+
+    struct Result {
+        std::string videoPath;
+        std::string cameraName;
+        bool ok = false;
+        std::string error;
+        uint64_t frames = 0;
+        double videoSeconds = 0.0;       // Stream time covered, from the last frame's PTS
+        double processingSeconds = 0.0;
+        size_t events = 0;
+        std::map<std::string, int> regionCounts;
+    };
+
+    struct Options {
+        std::string outputDir = "offline_output";
+        int jobs = 1;                      // Files processed at once
+        int periodicCaptureInterval = 30;  // Frames between PERIODIC events (as EventManager)
+        std::set<int> countClasses;        // Empty = count every class
+        bool roiInference = false;         // Detect only around the regions (see Region::getCombinedRoi)
+        float roiMarginRatio = 0.15f;
+    };
+
+    // `pool` should hold at least options.jobs instances, or workers wait for each other
+    OfflineProcessor(std::shared_ptr<InferencePool> pool, const Options& options);
+
+    // Process every job; blocks until all files are done. Results are in job order.
+    std::vector<Result> run(const std::vector<Job>& jobs);
+
+    static void printSummary(const std::vector<Result>& results, double wallSeconds);
+
+private:
+    Result processFile(const Job& job);
+
+    std::shared_ptr<InferencePool> pool_;
+    Options options_;
+};
+
+#endif // OFFLINEPROCESSOR_H
@@ -0,0 +1,130 @@
+#ifdef USE_ONNXRUNTIME
+
+#include "OnnxRuntimeBackend.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+Ort::Env &OnnxRuntimeBackend::environment()
+{
+    // One environment (logging, global thread pools) per process
+    static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "Yolov8CPPInference");
+    return env;
+}
+
+OnnxRuntimeBackend::OnnxRuntimeBackend(const std::vector<uchar> &onnxModelBuffer, const BackendOptions &options)
+{
+    sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    if (options.intraOpThreads > 0)
+        sessionOptions.SetIntraOpNumThreads(options.intraOpThreads);
+    if (options.interOpThreads > 0)
+    {
+        sessionOptions.SetExecutionMode(ExecutionMode::ORT_PARALLEL);
+        sessionOptions.SetInterOpNumThreads(options.interOpThreads);
+    }
+
+    session = std::make_unique<Ort::Session>(environment(), onnxModelBuffer.data(), onnxModelBuffer.size(), sessionOptions);
+    memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    inputName = session->GetInputNameAllocated(0, allocator).get();
+    outputName = session->GetOutputNameAllocated(0, allocator).get();
+    outputShapeTemplate = session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+
+    const ONNXTensorElementDataType inputType = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+    const ONNXTensorElementDataType outputType = session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+    auto supported = [](ONNXTensorElementDataType t) {
+        return t == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || t == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    };
+    if (!supported(inputType) || !supported(outputType))
+        throw std::runtime_error("Unsupported model I/O type: export quantized models in QDQ format with float32 input/output");
+
+    halfInput = inputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    halfOutput = outputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16;
+    precision = detectModelPrecision(onnxModelBuffer);
+    if (precision == ModelPrecision::FP32 && (halfInput || halfOutput))
+        precision = ModelPrecision::FP16;
+
+    std::cout << "\nRunning on ONNX Runtime CPU (intra-op threads: "
+              << (options.intraOpThreads > 0 ? std::to_string(options.intraOpThreads) : "default")
+              << ", inter-op threads: "
+              << (options.interOpThreads > 0 ? std::to_string(options.interOpThreads) : "default")
+              << ", precision: " << modelPrecisionName(precision) << ")" << std::endl;
+}
+
+cv::Mat OnnxRuntimeBackend::forward(const cv::Mat &blob)
+{
+    std::vector<int64_t> shape{blob.size[0], blob.size[1], blob.size[2], blob.size[3]};
+
+    if (halfInput)
+    {
+        // convertTo keeps the destination buffer while the shape is unchanged
+        blob.convertTo(halfBlob, CV_16F);
+        if (halfBlob.data != inputData || shape != inputShape)
+        {
+            inputTensor = Ort::Value::CreateTensor<Ort::Float16_t>(memoryInfo, halfBlob.ptr<Ort::Float16_t>(), halfBlob.total(),
+                                                                   shape.data(), shape.size());
+            inputData = halfBlob.data;
+            inputShape = shape;
+        }
+    }
+    // The preprocessor reuses its blob, so the wrapping tensor usually survives between calls
+    else if (blob.data != inputData || shape != inputShape)
+    {
+        inputTensor = Ort::Value::CreateTensor<float>(memoryInfo, const_cast<float *>(blob.ptr<float>()), blob.total(),
+                                                      shape.data(), shape.size());
+        inputData = blob.data;
+        inputShape = shape;
+    }
+
+    const char *inputNames[] = {inputName.c_str()};
+    const char *outputNames[] = {outputName.c_str()};
+
+    std::vector<int64_t> expected = outputShapeTemplate;
+    if (!expected.empty() && expected[0] < 0)
+        expected[0] = shape[0];
+
+    const bool shapeKnown = !expected.empty() &&
+                            std::all_of(expected.begin(), expected.end(), [](int64_t d) { return d > 0; });
+    if (!shapeKnown)
+    {
+        // Dynamic output dimensions: let the runtime allocate once and learn the shape
+        std::vector<Ort::Value> results = session->Run(Ort::RunOptions{nullptr}, inputNames, &inputTensor, 1, outputNames, 1);
+        std::vector<int64_t> dims = results[0].GetTensorTypeAndShapeInfo().GetShape();
+        std::vector<int> sizes(dims.begin(), dims.end());
+        if (halfOutput)
+            cv::Mat(static_cast<int>(sizes.size()), sizes.data(), CV_16F, results[0].GetTensorMutableData<Ort::Float16_t>()).convertTo(output, CV_32F);
+        else
+            cv::Mat(static_cast<int>(sizes.size()), sizes.data(), CV_32F, results[0].GetTensorMutableData<float>()).copyTo(output);
+
+        outputShapeTemplate = dims;
+        outputShapeTemplate[0] = -1;
+        outputShape.clear();
+        return output;
+    }
+
+    if (expected != outputShape || output.empty())
+    {
+        std::vector<int> sizes(expected.begin(), expected.end());
+        output.create(static_cast<int>(sizes.size()), sizes.data(), CV_32F);
+        if (halfOutput)
+        {
+            halfOutputBuffer.create(static_cast<int>(sizes.size()), sizes.data(), CV_16F);
+            outputTensor = Ort::Value::CreateTensor<Ort::Float16_t>(memoryInfo, halfOutputBuffer.ptr<Ort::Float16_t>(),
+                                                                    halfOutputBuffer.total(), expected.data(), expected.size());
+        }
+        else
+        {
+            outputTensor = Ort::Value::CreateTensor<float>(memoryInfo, output.ptr<float>(), output.total(),
+                                                           expected.data(), expected.size());
+        }
+        outputShape = expected;
+    }
+
+    session->Run(Ort::RunOptions{nullptr}, inputNames, &inputTensor, 1, outputNames, &outputTensor, 1);
+    if (halfOutput)
+        halfOutputBuffer.convertTo(output, CV_32F);
+    return output;
+}
+
+#endif // USE_ONNXRUNTIME
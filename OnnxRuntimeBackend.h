@@ -0,0 +1,59 @@
+#ifndef ONNXRUNTIMEBACKEND_H
+#define ONNXRUNTIMEBACKEND_H
+
+#ifdef USE_ONNXRUNTIME
+
+#include <onnxruntime_cxx_api.h>
+#include "DetectorBackend.h"
+
+/**
+ * @brief ONNX Runtime backend (CPU execution provider)
+ *
+ * The input tensor wraps the preprocessor's blob without a copy and is only
+ * rebuilt when the blob memory or batch size changes. The output tensor is
+ * bound to a preallocated cv::Mat of the model's output shape, so steady-state
+ * calls allocate nothing.
+ *
+ * FP16 models (float16 input/output) are fed a converted copy of the blob and
+ * their output is widened back to float32. Quantized QDQ models keep float32
+ * I/O and run through the same zero-copy path.
+ */
+class OnnxRuntimeBackend : public DetectorBackend
+{
+public:
+    OnnxRuntimeBackend(const std::vector<uchar> &onnxModelBuffer, const BackendOptions &options);
+
+    std::string getName() const override { return "ONNX Runtime (CPU)"; }
+    ModelPrecision getPrecision() const override { return precision; }
+    cv::Mat forward(const cv::Mat &blob) override;
+
+private:
+    static Ort::Env &environment();
+
+    Ort::SessionOptions sessionOptions;
+    std::unique_ptr<Ort::Session> session;
+    Ort::MemoryInfo memoryInfo{nullptr};
+
+    std::string inputName;
+    std::string outputName;
+    std::vector<int64_t> outputShapeTemplate;  // -1 where the model has a dynamic dimension
+    ModelPrecision precision{ModelPrecision::FP32};
+    bool halfInput{false};
+    bool halfOutput{false};
+
+    // Reused tensors
+    Ort::Value inputTensor{nullptr};
+    const void *inputData{nullptr};
+    std::vector<int64_t> inputShape;
+
+    cv::Mat halfBlob;  // FP16 copy of the input blob
+
+    Ort::Value outputTensor{nullptr};
+    cv::Mat output;
+    cv::Mat halfOutputBuffer;  // FP16 output before widening
+    std::vector<int64_t> outputShape;
+};
+
+#endif // USE_ONNXRUNTIME
+
+#endif // ONNXRUNTIMEBACKEND_H
@@ -0,0 +1,39 @@
+#include "OpenCvDnnBackend.h"
+#include <iostream>
+
+OpenCvDnnBackend::OpenCvDnnBackend(const std::vector<uchar> &onnxModelBuffer, bool useCuda)
+    : cudaEnabled(useCuda)
+{
+    // The ONNX importer handles QDQ graphs and FP16 initializers; I/O stays float32
+    net = cv::dnn::readNetFromONNX(onnxModelBuffer);
+    precision = detectModelPrecision(onnxModelBuffer);
+
+    if (cudaEnabled)
+    {
+        std::cout << "\nRunning on CUDA" << std::endl;
+        net.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
+        net.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
+    }
+    else
+    {
+        std::cout << "\nRunning on CPU" << std::endl;
+        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    }
+
+    outputNames = net.getUnconnectedOutLayersNames();
+}
+
+cv::Mat OpenCvDnnBackend::forward(const cv::Mat &blob)
+{
+    net.setInput(blob);
+    net.forward(outputs, outputNames);
+
+    // FP16 targets can hand back half-precision blobs; the decoder reads float32
+    if (outputs[0].depth() != CV_32F)
+    {
+        outputs[0].convertTo(converted, CV_32F);
+        return converted;
+    }
+    return outputs[0];
+}
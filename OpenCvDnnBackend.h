@@ -0,0 +1,26 @@
+#ifndef OPENCVDNNBACKEND_H
+#define OPENCVDNNBACKEND_H
+
+#include <opencv2/dnn.hpp>
+#include "DetectorBackend.h"
+
+// cv::dnn::Net backend (OpenCV CPU or CUDA target)
+class OpenCvDnnBackend : public DetectorBackend
+{
+public:
+    OpenCvDnnBackend(const std::vector<uchar> &onnxModelBuffer, bool useCuda);
+
+    std::string getName() const override { return cudaEnabled ? "OpenCV DNN (CUDA)" : "OpenCV DNN (CPU)"; }
+    ModelPrecision getPrecision() const override { return precision; }
+    cv::Mat forward(const cv::Mat &blob) override;
+
+private:
+    cv::dnn::Net net;
+    std::vector<std::string> outputNames;
+    std::vector<cv::Mat> outputs;
+    cv::Mat converted;
+    bool cudaEnabled{false};
+    ModelPrecision precision{ModelPrecision::FP32};
+};
+
+#endif // OPENCVDNNBACKEND_H
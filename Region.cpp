@@ -54,6 +54,48 @@ cv::Rect Region::getBoundingBox() const {
     return cv::Rect(minX, minY, maxX - minX, maxY - minY);
 }
 
+Region Region::scaledTo(const cv::Size& frameSize) const {
+    if (frameSize_.empty() || frameSize.empty() || frameSize_ == frameSize) {
+        return *this;
+    }
+
+    double scaleX = static_cast<double>(frameSize.width) / frameSize_.width;
+    double scaleY = static_cast<double>(frameSize.height) / frameSize_.height;
+
+    Region scaled = *this;
+    for (auto& pt : scaled.points_) {
+        pt.x = cvRound(pt.x * scaleX);
+        pt.y = cvRound(pt.y * scaleY);
+    }
+    scaled.frameSize_ = frameSize;
+    return scaled;
+}
+
+cv::Rect Region::getCombinedRoi(const std::vector<Region>& regions, const cv::Size& frameSize,
+                               float marginRatio) {
+    cv::Rect roi;
+    for (const auto& region : regions) {
+        cv::Rect box = region.getBoundingBox();
+        if (box.width <= 0 || box.height <= 0) {
+            continue;
+        }
+        roi = roi.empty() ? box : (roi | box);
+    }
+
+    if (roi.empty()) {
+        return cv::Rect();
+    }
+
+    // Objects are assigned by their center, so they can extend past the region outline
+    int margin = static_cast<int>(std::max(roi.width, roi.height) * marginRatio);
+    roi.x -= margin;
+    roi.y -= margin;
+    roi.width += 2 * margin;
+    roi.height += 2 * margin;
+
+    return roi & cv::Rect(0, 0, frameSize.width, frameSize.height);
+}
+
 json Region::toJson() const {
     json j;
     j["name"] = name_;
@@ -69,6 +111,10 @@ json Region::toJson() const {
         {"r", static_cast<int>(color_[2])}
     };
 
+    if (!frameSize_.empty()) {
+        j["frame_size"] = {{"width", frameSize_.width}, {"height", frameSize_.height}};
+    }
+
     return j;
 }
 
@@ -95,5 +141,10 @@ Region Region::fromJson(const json& j) {
         region.color_ = cv::Scalar(b, g, r);
     }
 
+    if (j.contains("frame_size")) {
+        region.frameSize_ = cv::Size(j["frame_size"]["width"].get<int>(),
+                                     j["frame_size"]["height"].get<int>());
+    }
+
     return region;
 }
@@ -18,16 +18,29 @@ public:
     const std::vector<cv::Point>& getPoints() const { return points_; }
     cv::Scalar getColor() const { return color_; }
 
+    // Size of the frame the points were drawn on (empty for regions saved before it was recorded)
+    cv::Size getFrameSize() const { return frameSize_; }
+
     // Setters
     void setName(const std::string& name) { name_ = name; }
     void setPoints(const std::vector<cv::Point>& points) { points_ = points; }
     void setColor(const cv::Scalar& color) { color_ = color; }
+    void setFrameSize(const cv::Size& frameSize) { frameSize_ = frameSize; }
 
     // Geometry utilities
     bool containsPoint(const cv::Point& point) const;
     bool containsRect(const cv::Rect& rect) const;  // Check if rect center is inside
     cv::Rect getBoundingBox() const;
 
+    // Copy with the points mapped from the drawing frame size to frameSize
+    // (e.g. main stream -> substream); unchanged if the drawing size is unknown
+    Region scaledTo(const cv::Size& frameSize) const;
+
+    // Union of the regions' bounding boxes, grown by marginRatio * its longer side
+    // and clipped to the frame (empty rect if there are no regions)
+    static cv::Rect getCombinedRoi(const std::vector<Region>& regions, const cv::Size& frameSize,
+                                   float marginRatio);
+
     // Serialization
     json toJson() const;
     static Region fromJson(const json& j);
@@ -36,6 +49,7 @@ private:
     std::string name_;
     std::vector<cv::Point> points_;
     cv::Scalar color_;  // For visualization
+    cv::Size frameSize_;
 
     void generateRandomColor();
 };
@@ -0,0 +1,115 @@
+#include "RegionTracker.h"
+#include "yolo_to_bytetrack.h"
+#include <algorithm>
+
+RegionTracker::RegionTracker(int frameRate) {
+    // Parameters: frame_rate, track_buffer, track_thresh, high_thresh, match_thresh
+    tracker_ = std::make_unique<byte_track::BYTETracker>(frameRate, 30, 0.5, 0.6, 0.8);
+}
+
+std::vector<TrackedBox> RegionTracker::track(std::vector<Detection>& detections, const std::set<int>& countClasses,
+                                             const std::vector<Region>& regions) {
+    // Class filter, then region filter, compacting in place
+    detections.erase(std::remove_if(detections.begin(), detections.end(),
+                                    [&countClasses, &regions](const Detection& det) {
+                                        if (!countClasses.empty() && !countClasses.count(det.class_id)) {
+                                            return true;
+                                        }
+                                        return !regions.empty() &&
+                                               std::none_of(regions.begin(), regions.end(),
+                                                            [&det](const Region& region) {
+                                                                return region.containsRect(det.box);
+                                                            });
+                                    }),
+                     detections.end());
+
+    convertToByteTrackObjects(detections, trackerObjects_);
+    std::vector<byte_track::BYTETracker::STrackPtr> tracks = tracker_->update(trackerObjects_);
+
+    std::vector<TrackedBox> tracked;
+    tracked.reserve(tracks.size());
+    for (const auto& track : tracks) {
+        const auto& rect = track->getRect();
+
+        TrackedBox box;
+        box.trackId = track->getTrackId();
+        box.score = track->getScore();
+        box.box = cv::Rect(static_cast<int>(rect.x()), static_cast<int>(rect.y()),
+                           static_cast<int>(rect.width()), static_cast<int>(rect.height()));
+
+        // Class of the best-overlapping detection keeps the label stable between frames
+        float bestIou = 0.3f;
+        int bestClassId = -1;
+        for (const auto& det : detections) {
+            float iou = calcIoU(box.box, det.box);
+            if (iou > bestIou) {
+                bestIou = iou;
+                bestClassId = det.class_id;
+            }
+        }
+        if (bestClassId >= 0) {
+            trackClassMap_[box.trackId] = bestClassId;
+        }
+
+        tracked.push_back(box);
+    }
+    return tracked;
+}
+
+void RegionTracker::predict() {
+    trackerObjects_.clear();
+    tracker_->update(trackerObjects_);
+}
+
+RegionTracker::RegionUpdate RegionTracker::updateRegions(const std::vector<TrackedBox>& tracks,
+                                                         const std::vector<Region>& regions,
+                                                         int frameNumber, int periodicInterval) {
+    RegionUpdate update;
+    update.trackRegions.reserve(tracks.size());
+
+    for (const auto& track : tracks) {
+        std::string regionName;
+        for (const auto& region : regions) {
+            if (region.containsRect(track.box)) {
+                regionName = region.getName();
+                break;
+            }
+        }
+
+        if (!regionName.empty()) {
+            // Class filtering already happened in track(), so every ID here counts
+            regionObjectIds_[regionName].insert(track.trackId);
+
+            TrackRegionState& state = trackRegionStates_[track.trackId];
+            if (!state.inRegion) {
+                update.events.push_back({track.trackId, regionName, track.box, track.score, EventType::FIRST_ENTRY});
+                update.regionEntered = true;
+                state.inRegion = true;
+                state.regionName = regionName;
+                state.lastCaptureFrame = frameNumber;
+            } else if (frameNumber - state.lastCaptureFrame >= periodicInterval) {
+                update.events.push_back({track.trackId, regionName, track.box, track.score, EventType::PERIODIC});
+                state.lastCaptureFrame = frameNumber;
+            }
+        } else {
+            auto it = trackRegionStates_.find(track.trackId);
+            if (it != trackRegionStates_.end() && it->second.inRegion) {
+                update.events.push_back({track.trackId, it->second.regionName, track.box, track.score, EventType::EXIT});
+                trackRegionStates_.erase(it);
+            }
+        }
+
+        update.trackRegions.push_back(regionName);
+    }
+
+    for (const auto& region : regions) {
+        auto it = regionObjectIds_.find(region.getName());
+        update.regionCounts[region.getName()] = it != regionObjectIds_.end() ? static_cast<int>(it->second.size()) : 0;
+    }
+    return update;
+}
+
+int RegionTracker::getTrackClass(size_t trackId) const {
+    auto it = trackClassMap_.find(trackId);
+    return it != trackClassMap_.end() ? it->second : -1;
+}
@@ -0,0 +1,101 @@
+#ifndef REGIONTRACKER_H
+#define REGIONTRACKER_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "inference.h"
+#include "ByteTrack/BYTETracker.h"
+#include "DetectionScheduler.h"
+#include "DetectionEvent.h"
+#include "Region.h"
+
+/**
+ * @brief Counting core shared by the live pipeline and offline processing
+ *
+ * Class filter, region filter, ByteTrack, track classes and the per-region
+ * entry / periodic / exit state with unique IDs per region. It only decides
+ * what happened; saving crops, EventManager, RegionCountManager and
+ * Telegram are left to the caller, so CameraPipeline and OfflineProcessor
+ * count the same way and only differ in where events go.
+ *
+ * Not thread-safe: one instance per camera (or file), fed frames in order.
+ */
+class RegionTracker {
+public:
+    struct Event {
+        size_t trackId = 0;
+        std::string regionName;
+        cv::Rect box;
+        float score = 0.0f;
+        EventType type = EventType::FIRST_ENTRY;
+    };
+
+    // Region side of one frame
+    struct RegionUpdate {
+        std::vector<std::string> trackRegions;   // Parallel to the tracks; empty = in no region
+        std::vector<Event> events;               // In track order
+        std::map<std::string, int> regionCounts; // Unique IDs so far, for every region (0 if none)
+        bool regionEntered = false;              // At least one FIRST_ENTRY this frame
+    };
+
+    // Track buffer is in frames; ByteTrack scales it by frameRate / 30
+    explicit RegionTracker(int frameRate = 30);
+
+    /**
+     * @brief Filter detections in place and update the tracker with them
+     * @param countClasses Classes to keep (empty = all)
+     * @param regions If not empty, detections whose center is in no region are dropped
+     * @return The tracker's active tracks
+     *
+     * An empty detection list still ticks the tracker (frames without motion).
+     */
+    std::vector<TrackedBox> track(std::vector<Detection>& detections, const std::set<int>& countClasses,
+                                  const std::vector<Region>& regions);
+
+    /**
+     * @brief Advance the tracker over a frame the detector skipped
+     *
+     * Kalman prediction only (an empty update): the tracker sees every real
+     * frame, so its velocities stay per frame and the track buffer counts
+     * frames whatever the detection interval. Tracks keep their IDs and are
+     * matched again on the next detection.
+     */
+    void predict();
+
+    /**
+     * @brief Region membership and events of this frame's tracks
+     * @param tracks Output of track(), or boxes predicted between detections
+     * @param periodicInterval Frames between PERIODIC events of a track staying in a region
+     */
+    RegionUpdate updateRegions(const std::vector<TrackedBox>& tracks, const std::vector<Region>& regions,
+                               int frameNumber, int periodicInterval);
+
+    // Class ID last matched to the track, -1 if none yet
+    int getTrackClass(size_t trackId) const;
+
+    // Forget track classes (the model's class list changed); tracks and counts stay
+    void clearTrackClasses() { trackClassMap_.clear(); }
+
+    const std::map<std::string, std::set<size_t>>& getRegionObjectIds() const { return regionObjectIds_; }
+
+private:
+    struct TrackRegionState {
+        bool inRegion = false;
+        std::string regionName;
+        int lastCaptureFrame = 0;
+    };
+
+    std::unique_ptr<byte_track::BYTETracker> tracker_;
+    std::vector<byte_track::Object> trackerObjects_;
+    std::map<size_t, int> trackClassMap_;  // Track ID -> class ID for consistent labeling
+    std::map<size_t, TrackRegionState> trackRegionStates_;
+    std::map<std::string, std::set<size_t>> regionObjectIds_;
+};
+
+#endif // REGIONTRACKER_H
@@ -0,0 +1,84 @@
+#include "SourceRegistry.h"
+#include <iostream>
+
+SourceRegistry& SourceRegistry::getInstance() {
+    static SourceRegistry instance;
+    return instance;
+}
+
+std::string SourceRegistry::makeKey(const FrameGrabber::CaptureSpec& spec) {
+    std::string key = spec.isDevice ? "device:" : "url:";
+    key += spec.source;
+    if (spec.decodeOnDemand) {
+        key += "#on-demand";
+    }
+    return key;
+}
+
+std::shared_ptr<FrameGrabber> SourceRegistry::acquire(const FrameGrabber::CaptureSpec& spec, const std::string& name) {
+    const std::string key = makeKey(spec);
+
+    // A camera opening the same source finishes first, so the source is not opened twice;
+    // other sources do not wait on it (webcams and files open synchronously in start())
+    std::unique_lock<std::mutex> lock(mutex_);
+    openingDone_.wait(lock, [this, &key]() { return !opening_.count(key); });
+
+    auto it = sources_.find(key);
+    if (it != sources_.end()) {
+        std::shared_ptr<FrameGrabber> grabber = it->second.lock();
+        if (grabber && !grabber->hasFailed()) {
+            std::cout << "🔗 Camera '" << name << "' shares the decoder of " << spec.source
+                      << " (" << grabber.use_count() - 1 << " other user(s))" << std::endl;
+            return grabber;
+        }
+        if (grabber) {
+            // Ended (end of file, device gone without a reconnect policy) and will not come back;
+            // its current users keep it until they reopen, which then finds the new one
+            std::cout << "🔄 Decoder of " << spec.source << " has ended, opening the source again for camera '"
+                      << name << "'" << std::endl;
+        }
+    }
+
+    // Capture buffers get a pool of their own: they are shared by every user of the source and
+    // outlive whichever camera opened it, so they cannot come from that camera's pool
+    auto grabber = std::make_shared<FrameGrabber>(name, std::make_shared<FramePool>(name));
+    opening_.insert(key);
+    lock.unlock();
+
+    bool started = false;
+    try {
+        started = grabber->start(spec);
+    } catch (...) {
+        lock.lock();
+        opening_.erase(key);
+        lock.unlock();
+        openingDone_.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    opening_.erase(key);
+    if (started) {
+        sources_[key] = grabber;
+
+        // Drop entries whose grabbers have been released
+        for (auto entry = sources_.begin(); entry != sources_.end();) {
+            entry = entry->second.expired() ? sources_.erase(entry) : std::next(entry);
+        }
+    }
+    lock.unlock();
+    openingDone_.notify_all();
+
+    return started ? grabber : nullptr;
+}
+
+size_t SourceRegistry::getActiveSourceCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& entry : sources_) {
+        if (!entry.second.expired()) {
+            ++count;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,61 @@
+#ifndef SOURCEREGISTRY_H
+#define SOURCEREGISTRY_H
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "FrameGrabber.h"
+
+/**
+ * @brief Deduplicates capture threads across cameras that open the same source
+ *
+ * Two configured cameras pointing at the same RTSP URL, device or file (or a
+ * full-screen view of a running camera) share one FrameGrabber, so the
+ * stream is decoded once and fanned out to every subscriber. The registry
+ * only holds weak references: the grabber stops when its last user releases
+ * it, and the next acquire() opens the source again. A grabber whose source
+ * has ended is never handed out again; acquire() replaces it with a fresh one.
+ */
+class SourceRegistry {
+public:
+    // Singleton access
+    static SourceRegistry& getInstance();
+
+    // Delete copy/move constructors and assignment operators
+    SourceRegistry(const SourceRegistry&) = delete;
+    SourceRegistry& operator=(const SourceRegistry&) = delete;
+    SourceRegistry(SourceRegistry&&) = delete;
+    SourceRegistry& operator=(SourceRegistry&&) = delete;
+
+    /**
+     * @brief Running grabber for `spec`, started on first use
+     * @param name Camera name used in the grabber's log messages (first user wins)
+     * @return nullptr if the source cannot be opened
+     *
+     * Sources match on location, device flag and decode mode; timeouts and
+     * reconnect policy are those of the first user. A caller asking for a
+     * source that is being opened waits for that open; other sources are
+     * opened in parallel.
+     */
+    std::shared_ptr<FrameGrabber> acquire(const FrameGrabber::CaptureSpec& spec, const std::string& name);
+
+    // Number of sources currently decoded
+    size_t getActiveSourceCount() const;
+
+private:
+    SourceRegistry() = default;
+    ~SourceRegistry() = default;
+
+    static std::string makeKey(const FrameGrabber::CaptureSpec& spec);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::weak_ptr<FrameGrabber>> sources_;
+    std::set<std::string> opening_;  // Keys whose start() is running outside the lock
+    std::condition_variable openingDone_;
+};
+
+#endif // SOURCEREGISTRY_H
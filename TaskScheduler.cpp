@@ -0,0 +1,188 @@
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <opencv2/core.hpp>
+
+namespace {
+
+// Index of the worker running on this thread, or -1 outside the pool
+thread_local int currentWorker = -1;
+
+} // namespace
+
+void TaskScheduler::Strand::post(Task task) {
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        schedule = !scheduled_;
+        scheduled_ = true;
+    }
+    if (schedule) {
+        auto self = shared_from_this();
+        scheduler_.submit([self]() { self->drain(); });
+    }
+}
+
+size_t TaskScheduler::Strand::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void TaskScheduler::Strand::drain() {
+    Task task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task = std::move(tasks_.front());
+    }
+
+    try {
+        task();
+    } catch (const std::exception& e) {
+        std::cerr << "TaskScheduler: strand task failed: " << e.what() << std::endl;
+    } catch (...) {
+        // Anything else would end the process from a worker thread
+        std::cerr << "TaskScheduler: strand task failed with a non-standard exception" << std::endl;
+    }
+
+    // One task per drain, then requeue: a busy camera cannot hold a worker while others wait
+    bool more;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.pop_front();
+        more = !tasks_.empty();
+        scheduled_ = more;
+    }
+    if (more) {
+        auto self = shared_from_this();
+        scheduler_.submit([self]() { self->drain(); });
+    }
+}
+
+TaskScheduler& TaskScheduler::getInstance() {
+    static TaskScheduler instance;
+    return instance;
+}
+
+int TaskScheduler::defaultWorkerCount() {
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(2, cores / 2);
+}
+
+void TaskScheduler::coordinateOpenCvThreads(int concurrentForwardPasses) {
+    int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int detectionCores = std::max(1, cores - defaultWorkerCount());
+    int passes = std::max(1, concurrentForwardPasses);
+    int threads = std::max(1, detectionCores - (passes - 1));
+
+    cv::setNumThreads(threads);
+    std::cout << "TaskScheduler: " << defaultWorkerCount() << " pipeline worker(s), "
+              << threads << " OpenCV thread(s) shared by up to " << passes
+              << " concurrent forward pass(es) on " << cores << " core(s)" << std::endl;
+}
+
+TaskScheduler::TaskScheduler() {
+    int count = defaultWorkerCount();
+    for (int i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < count; ++i) {
+        threads_.emplace_back(&TaskScheduler::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wakeup_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void TaskScheduler::submit(Task task) {
+    // From a worker: its own deque, so follow-up work stays on the core that has the data
+    size_t index = currentWorker >= 0 ? static_cast<size_t>(currentWorker)
+                                      : nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Taking the lock orders the push before a sleeping worker's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    wakeup_.notify_one();
+}
+
+std::shared_ptr<TaskScheduler::Strand> TaskScheduler::makeStrand() {
+    return std::make_shared<Strand>(*this);
+}
+
+TaskScheduler::Stats TaskScheduler::getStats() const {
+    Stats stats;
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool TaskScheduler::takeTask(size_t index, Task& task) {
+    // Own deque first, newest task
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // Then steal the oldest task of another worker
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::workerLoop(size_t index) {
+    currentWorker = static_cast<int>(index);
+
+    while (true) {
+        Task task;
+        if (takeTask(index, task)) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "TaskScheduler: task failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "TaskScheduler: task failed with a non-standard exception" << std::endl;
+            }
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeup_.wait(lock, [this]() {
+            return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool shared by every camera pipeline
+ *
+ * One worker per share of the cores instead of a fixed set of threads per
+ * camera: quiet cameras cost nothing, and busy ones use whatever workers
+ * are free. Each worker owns a deque; tasks submitted from a worker go to
+ * the back of its own deque and are taken LIFO (the data is still in cache),
+ * idle workers steal from the front of the others' deques.
+ *
+ * Work that must stay in order (a camera's tracker, its event state) goes
+ * through a Strand: its tasks run one at a time, in submission order, on
+ * whichever worker picks them up.
+ *
+ * Tasks should not block: a task waiting on I/O or a future holds a worker
+ * that other cameras could use. Capture stays on the per-source FrameGrabber
+ * threads, and forward passes run on BatchInferenceEngine's threads and
+ * complete through a callback.
+ */
+class TaskScheduler {
+public:
+    using Task = std::function<void()>;
+
+    // Serial queue on top of the pool; keep it in a shared_ptr (see makeStrand)
+    class Strand : public std::enable_shared_from_this<Strand> {
+    public:
+        explicit Strand(TaskScheduler& scheduler) : scheduler_(scheduler) {}
+
+        // Runs after every task posted to this strand before it
+        void post(Task task);
+
+        // Tasks posted and not yet finished
+        size_t getPendingCount() const;
+
+    private:
+        void drain();
+
+        TaskScheduler& scheduler_;
+        mutable std::mutex mutex_;
+        std::deque<Task> tasks_;
+        bool scheduled_ = false;  // A drain task is queued or running
+    };
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;  // Tasks run by a worker other than the one they were queued on
+    };
+
+    // Singleton access; workers start on first use
+    static TaskScheduler& getInstance();
+
+    // Delete copy/move constructors and assignment operators
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    void submit(Task task);
+
+    // Strands keep themselves alive while a drain task is in flight
+    std::shared_ptr<Strand> makeStrand();
+
+    int getWorkerCount() const { return static_cast<int>(workers_.size()); }
+    Stats getStats() const;
+
+    // Half the hardware threads (at least 2); the other half is left to detection
+    static int defaultWorkerCount();
+
+    /**
+     * @brief Give OpenCV's internal thread pool the cores the workers leave free
+     * @param concurrentForwardPasses Detector instances that can run at once (InferencePool size)
+     *
+     * Forward passes run on the detection engine's threads, not on the
+     * workers. cv::setNumThreads is process-wide: every concurrent pass
+     * shares the one OpenCV pool, and each pass beyond the first also keeps
+     * its calling thread busy. The pool is sized so that those callers and
+     * the pool together fit in the cores the workers leave free.
+     */
+    static void coordinateOpenCvThreads(int concurrentForwardPasses);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    TaskScheduler();
+    ~TaskScheduler();
+
+    void workerLoop(size_t index);
+    bool takeTask(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> nextWorker_{0};
+
+    // Idle workers sleep here until a task is queued anywhere
+    std::mutex sleepMutex_;
+    std::condition_variable wakeup_;
+    std::atomic<size_t> queued_{0};  // Tasks in all deques; changed under the deque's lock
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> stolen_{0};
+};
+
+#endif // TASKSCHEDULER_H
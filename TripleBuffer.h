@@ -0,0 +1,62 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <utility>
+
+/**
+ * @brief Lock-free newest-value-wins handoff between one producer and one consumer
+ *
+ * Three slots: the producer fills its back slot and swaps it with the middle
+ * one, the consumer swaps its front slot with the middle one when that holds
+ * an unread value. Both swaps are a single atomic exchange, so neither side
+ * ever waits for the other; a value the consumer did not take before the
+ * next write is dropped.
+ *
+ * Slots are reset as soon as they change hands, so a dropped or taken value
+ * (and the buffer behind it) is not kept alive inside the exchange.
+ *
+ * Single producer, single consumer; T must be default-constructible and movable.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer: publish a value; true if it replaced one the consumer never took
+    bool write(T&& value) {
+        slots_[back_] = std::move(value);
+        int previous = middle_.exchange(back_ | kFreshBit, std::memory_order_acq_rel);
+        back_ = previous & kIndexMask;
+        slots_[back_] = T();
+        return (previous & kFreshBit) != 0;
+    }
+
+    // Consumer: take the newest value; false if nothing was written since the last read
+    bool read(T& value) {
+        if (!hasFresh()) {
+            return false;
+        }
+        int previous = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = previous & kIndexMask;
+        value = std::move(slots_[front_]);
+        slots_[front_] = T();
+        return true;
+    }
+
+    bool hasFresh() const { return (middle_.load(std::memory_order_acquire) & kFreshBit) != 0; }
+
+private:
+    static constexpr int kFreshBit = 4;  // Set in middle_ while it holds an unread value
+    static constexpr int kIndexMask = 3;
+
+    std::array<T, 3> slots_;
+    int back_ = 0;    // Producer only
+    int front_ = 1;   // Consumer only
+    std::atomic<int> middle_{2};
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,345 @@
+#include "YoloDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <opencv2/core/hal/intrin.hpp>
+
+namespace {
+
+// Anchors processed per pass over the class rows; keeps the running maxima in L1
+constexpr int kAnchorBlock = 256;
+
+inline cv::Rect toSourceRect(float x, float y, float w, float h, const LetterboxInfo &info)
+{
+    int left = int((x - 0.5 * w - info.pad_x) / info.scale);
+    int top = int((y - 0.5 * h - info.pad_y) / info.scale);
+
+    int width = int(w / info.scale);
+    int height = int(h / info.scale);
+
+    return cv::Rect(left, top, width, height);
+}
+
+// Append anchor `anchor` of a channel-major YOLOv8 tensor
+inline void pushYoloV8(const float *data, size_t anchors, int anchor, int classId, float score,
+                       const LetterboxInfo &info, DecodedCandidates &out)
+{
+    float x = data[anchor];
+    float y = data[anchors + anchor];
+    float w = data[2 * anchors + anchor];
+    float h = data[3 * anchors + anchor];
+
+    out.confidences.push_back(score);
+    out.class_ids.push_back(classId);
+    out.boxes.push_back(toSourceRect(x, y, w, h, info));
+}
+
+} // namespace
+
+template <int NC>
+void YoloDecoder::decodeYoloV8Fixed(const float *data, const LetterboxInfo &info,
+                                    float /*confThreshold*/, float scoreThreshold,
+                                    DecodedCandidates &out) const
+{
+    const int anchors = numAnchors;
+    const int classes = NC > 0 ? NC : numClasses;
+    const float *scores = data + 4 * static_cast<size_t>(anchors);
+
+    if constexpr (NC == 1)
+    {
+        // Single class: the score row is already the maximum
+        for (int a = 0; a < anchors; ++a)
+        {
+            if (scores[a] > scoreThreshold)
+                pushYoloV8(data, anchors, a, 0, scores[a], info, out);
+        }
+    }
+    else
+    {
+        float blockMax[kAnchorBlock];
+
+        for (int start = 0; start < anchors; start += kAnchorBlock)
+        {
+            const int len = std::min(kAnchorBlock, anchors - start);
+            std::memcpy(blockMax, scores + start, len * sizeof(float));
+
+            for (int c = 1; c < classes; ++c)
+            {
+                const float *row = scores + static_cast<size_t>(c) * anchors + start;
+                int j = 0;
+#if CV_SIMD128
+                for (; j <= len - 4; j += 4)
+                {
+                    cv::v_float32x4 m = cv::v_max(cv::v_load(blockMax + j), cv::v_load(row + j));
+                    cv::v_store(blockMax + j, m);
+                }
+#endif
+                for (; j < len; ++j)
+                    blockMax[j] = std::max(blockMax[j], row[j]);
+            }
+
+            for (int j = 0; j < len; ++j)
+            {
+                if (blockMax[j] <= scoreThreshold)
+                    continue;
+
+                // First class reaching the maximum, same tie-breaking as minMaxLoc
+                const int a = start + j;
+                int classId = 0;
+                for (int c = 0; c < classes; ++c)
+                {
+                    if (scores[static_cast<size_t>(c) * anchors + a] == blockMax[j])
+                    {
+                        classId = c;
+                        break;
+                    }
+                }
+                pushYoloV8(data, anchors, a, classId, blockMax[j], info, out);
+            }
+        }
+    }
+}
+
+template <int NC>
+void YoloDecoder::decodeYoloV5Fixed(const float *data, const LetterboxInfo &info,
+                                    float confThreshold, float scoreThreshold,
+                                    DecodedCandidates &out) const
+{
+    const int classes = NC > 0 ? NC : numClasses;
+    const int stride = NC > 0 ? NC + 5 : dimensions;
+
+    for (int i = 0; i < numAnchors; ++i, data += stride)
+    {
+        float confidence = data[4];
+
+        // Objectness rejects most rows before any class score is read
+        if (confidence < confThreshold)
+            continue;
+
+        const float *classes_scores = data + 5;
+        int classId = 0;
+        float maxClassScore = classes_scores[0];
+        for (int c = 1; c < classes; ++c)
+        {
+            if (classes_scores[c] > maxClassScore)
+            {
+                maxClassScore = classes_scores[c];
+                classId = c;
+            }
+        }
+
+        if (maxClassScore > scoreThreshold)
+        {
+            out.confidences.push_back(confidence);
+            out.class_ids.push_back(classId);
+            out.boxes.push_back(toSourceRect(data[0], data[1], data[2], data[3], info));
+        }
+    }
+}
+
+void YoloDecoder::configure(int dim1, int dim2)
+{
+    // yolov5 has an output of shape (batchSize, 25200, 85) (Num classes + box[x,y,w,h] + confidence[c])
+    // yolov8 has an output of shape (batchSize, 84,  8400) (Num classes + box[x,y,w,h])
+    if (dim2 > dim1)
+    {
+        layout = Layout::YoloV8;
+        numAnchors = dim2;
+        dimensions = dim1;
+        numClasses = dim1 - 4;
+    }
+    else
+    {
+        layout = Layout::YoloV5;
+        numAnchors = dim1;
+        dimensions = dim2;
+        numClasses = dim2 - 5;
+    }
+
+    if (layout == Layout::YoloV8)
+    {
+        switch (numClasses)
+        {
+        case 1:  kernel = &YoloDecoder::decodeYoloV8Fixed<1>;  kernelName = "yolov8/1 class";    break;
+        case 2:  kernel = &YoloDecoder::decodeYoloV8Fixed<2>;  kernelName = "yolov8/2 classes";  break;
+        case 80: kernel = &YoloDecoder::decodeYoloV8Fixed<80>; kernelName = "yolov8/80 classes"; break;
+        default: kernel = &YoloDecoder::decodeYoloV8Fixed<0>;  kernelName = "yolov8/generic";    break;
+        }
+    }
+    else
+    {
+        switch (numClasses)
+        {
+        case 1:  kernel = &YoloDecoder::decodeYoloV5Fixed<1>;  kernelName = "yolov5/1 class";    break;
+        case 2:  kernel = &YoloDecoder::decodeYoloV5Fixed<2>;  kernelName = "yolov5/2 classes";  break;
+        case 80: kernel = &YoloDecoder::decodeYoloV5Fixed<80>; kernelName = "yolov5/80 classes"; break;
+        default: kernel = &YoloDecoder::decodeYoloV5Fixed<0>;  kernelName = "yolov5/generic";    break;
+        }
+    }
+}
+
+bool YoloDecoder::isConfiguredFor(int dim1, int dim2) const
+{
+    if (!kernel)
+        return false;
+
+    return layout == Layout::YoloV8 ? (dim1 == dimensions && dim2 == numAnchors)
+                                    : (dim1 == numAnchors && dim2 == dimensions);
+}
+
+void YoloDecoder::decode(const float *data, const LetterboxInfo &info,
+                         float confThreshold, float scoreThreshold,
+                         DecodedCandidates &out,
+                         const std::vector<int> *activeClasses) const
+{
+    if (numClasses <= 0 || numAnchors <= 0 || !kernel)
+        return;
+
+    if (activeClasses && activeClasses->empty())
+        activeClasses = nullptr;
+
+    if (!activeClasses)
+        (this->*kernel)(data, info, confThreshold, scoreThreshold, out);
+    else if (layout == Layout::YoloV8)
+        decodeYoloV8(data, info, scoreThreshold, out, activeClasses);
+    else
+        decodeYoloV5(data, info, confThreshold, scoreThreshold, out, activeClasses);
+}
+
+void YoloDecoder::decodeYoloV8(const float *data, const LetterboxInfo &info,
+                               float scoreThreshold, DecodedCandidates &out,
+                               const std::vector<int> *activeClasses) const
+{
+    const int anchors = numAnchors;
+    const float *scores = data + 4 * static_cast<size_t>(anchors);
+    const int classCount = activeClasses ? static_cast<int>(activeClasses->size()) : numClasses;
+    float blockMax[kAnchorBlock];
+
+    for (int start = 0; start < anchors; start += kAnchorBlock)
+    {
+        const int len = std::min(kAnchorBlock, anchors - start);
+        bool seeded = false;
+
+        // The first scored class seeds the running maximum, remaining class rows are folded in
+        for (int k = 0; k < classCount; ++k)
+        {
+            const int c = activeClasses ? (*activeClasses)[k] : k;
+            if (c < 0 || c >= numClasses)
+                continue;
+
+            const float *row = scores + static_cast<size_t>(c) * anchors + start;
+            if (!seeded)
+            {
+                std::memcpy(blockMax, row, len * sizeof(float));
+                seeded = true;
+                continue;
+            }
+
+            int j = 0;
+#if CV_SIMD128
+            for (; j <= len - 4; j += 4)
+            {
+                cv::v_float32x4 m = cv::v_max(cv::v_load(blockMax + j), cv::v_load(row + j));
+                cv::v_store(blockMax + j, m);
+            }
+#endif
+            for (; j < len; ++j)
+                blockMax[j] = std::max(blockMax[j], row[j]);
+        }
+
+        if (!seeded)
+            return;  // None of the active classes exist in this model
+
+        // Only survivors pay for the argmax and box materialization
+        for (int j = 0; j < len; ++j)
+        {
+            if (blockMax[j] > scoreThreshold)
+                emitYoloV8(data, start + j, blockMax[j], info, out, activeClasses);
+        }
+    }
+}
+
+void YoloDecoder::decodeYoloV8Scalar(const float *data, const LetterboxInfo &info,
+                                     float scoreThreshold, DecodedCandidates &out) const
+{
+    const int anchors = numAnchors;
+    const float *scores = data + 4 * static_cast<size_t>(anchors);
+
+    for (int a = 0; a < anchors; ++a)
+    {
+        float maxScore = scores[a];
+        for (int c = 1; c < numClasses; ++c)
+            maxScore = std::max(maxScore, scores[static_cast<size_t>(c) * anchors + a]);
+
+        if (maxScore > scoreThreshold)
+            emitYoloV8(data, a, maxScore, info, out, nullptr);
+    }
+}
+
+void YoloDecoder::emitYoloV8(const float *data, int anchor, float maxScore,
+                             const LetterboxInfo &info, DecodedCandidates &out,
+                             const std::vector<int> *activeClasses) const
+{
+    const size_t anchors = static_cast<size_t>(numAnchors);
+    const float *scores = data + 4 * anchors;
+    const int classCount = activeClasses ? static_cast<int>(activeClasses->size()) : numClasses;
+
+    // First class reaching the maximum, same tie-breaking as minMaxLoc
+    int classId = 0;
+    for (int k = 0; k < classCount; ++k)
+    {
+        const int c = activeClasses ? (*activeClasses)[k] : k;
+        if (c < 0 || c >= numClasses)
+            continue;
+
+        if (scores[c * anchors + anchor] == maxScore)
+        {
+            classId = c;
+            break;
+        }
+    }
+
+    pushYoloV8(data, anchors, anchor, classId, maxScore, info, out);
+}
+
+void YoloDecoder::decodeYoloV5(const float *data, const LetterboxInfo &info,
+                               float confThreshold, float scoreThreshold,
+                               DecodedCandidates &out,
+                               const std::vector<int> *activeClasses) const
+{
+    const int classCount = activeClasses ? static_cast<int>(activeClasses->size()) : numClasses;
+
+    for (int i = 0; i < numAnchors; ++i, data += dimensions)
+    {
+        float confidence = data[4];
+
+        // Objectness rejects most rows before any class score is read
+        if (confidence < confThreshold)
+            continue;
+
+        const float *classes_scores = data + 5;
+        int classId = -1;
+        float maxClassScore = 0.0f;
+        for (int k = 0; k < classCount; ++k)
+        {
+            const int c = activeClasses ? (*activeClasses)[k] : k;
+            if (c < 0 || c >= numClasses)
+                continue;
+
+            if (classId < 0 || classes_scores[c] > maxClassScore)
+            {
+                maxClassScore = classes_scores[c];
+                classId = c;
+            }
+        }
+
+        if (classId < 0)
+            return;  // None of the active classes exist in this model
+
+        if (maxClassScore > scoreThreshold)
+        {
+            out.confidences.push_back(confidence);
+            out.class_ids.push_back(classId);
+            out.boxes.push_back(toSourceRect(data[0], data[1], data[2], data[3], info));
+        }
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef YOLODECODER_H
+#define YOLODECODER_H
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "InferenceTypes.h"
+
+// Raw candidate boxes that passed the score threshold, before NMS
+struct DecodedCandidates
+{
+    std::vector<int> class_ids;
+    std::vector<float> confidences;
+    std::vector<cv::Rect> boxes;
+
+    void clear()
+    {
+        class_ids.clear();
+        confidences.clear();
+        boxes.clear();
+    }
+};
+
+/**
+ * @brief Decoder for raw YOLO output tensors
+ *
+ * YOLOv8 outputs are read in their native channel-major layout
+ * (4 + num_classes rows of num_anchors values), so no reshape/transpose is
+ * needed. The per-anchor class maximum is computed with OpenCV universal
+ * intrinsics over contiguous anchor runs; the argmax and box are only
+ * materialized for anchors whose maximum clears the score threshold.
+ *
+ * YOLOv5 outputs (anchor-major, objectness in column 4) are rejected on
+ * objectness before any class score is touched.
+ *
+ * configure() picks a kernel once per model: each layout has versions
+ * specialized for 1, 2 and 80 classes (compile-time class loops, no per-row
+ * layout branch) and a generic fallback for any other class count.
+ *
+ * An optional list of active class ids restricts scoring to those class
+ * channels; all other channels are never read.
+ */
+class YoloDecoder
+{
+public:
+    enum class Layout
+    {
+        YoloV5,  // (batch, anchors, 5 + classes)
+        YoloV8   // (batch, 4 + classes, anchors)
+    };
+
+    /**
+     * @brief Detect layout and class count from a (batch, a, b) output shape
+     */
+    void configure(int dim1, int dim2);
+
+    // True once configure() has run for this output shape
+    bool isConfiguredFor(int dim1, int dim2) const;
+
+    Layout getLayout() const { return layout; }
+    int getNumAnchors() const { return numAnchors; }
+    int getNumClasses() const { return numClasses; }
+
+    // Kernel selected by configure(), e.g. "yolov8/80 classes" or "yolov5/generic"
+    const char *getKernelName() const { return kernelName; }
+
+    /**
+     * @brief Decode one batch entry
+     * @param data Pointer to the first value of this batch entry
+     * @param info Letterbox geometry used to map boxes back to the source frame
+     * @param confThreshold Objectness threshold (YOLOv5 only)
+     * @param scoreThreshold Class score threshold
+     * @param out Candidates are appended here
+     * @param activeClasses Class ids to score (nullptr = all classes)
+     */
+    void decode(const float *data, const LetterboxInfo &info,
+                float confThreshold, float scoreThreshold,
+                DecodedCandidates &out,
+                const std::vector<int> *activeClasses = nullptr) const;
+
+    // Scalar reference implementation of the YOLOv8 path (used as fallback and for benchmarking)
+    void decodeYoloV8Scalar(const float *data, const LetterboxInfo &info,
+                            float scoreThreshold, DecodedCandidates &out) const;
+
+private:
+    using Kernel = void (YoloDecoder::*)(const float *, const LetterboxInfo &, float, float, DecodedCandidates &) const;
+
+    // All-classes kernels; NC = 0 reads the class count at runtime
+    template <int NC>
+    void decodeYoloV8Fixed(const float *data, const LetterboxInfo &info,
+                           float confThreshold, float scoreThreshold, DecodedCandidates &out) const;
+    template <int NC>
+    void decodeYoloV5Fixed(const float *data, const LetterboxInfo &info,
+                           float confThreshold, float scoreThreshold, DecodedCandidates &out) const;
+
+    // Active-class kernels
+    void decodeYoloV8(const float *data, const LetterboxInfo &info,
+                      float scoreThreshold, DecodedCandidates &out,
+                      const std::vector<int> *activeClasses) const;
+    void decodeYoloV5(const float *data, const LetterboxInfo &info,
+                      float confThreshold, float scoreThreshold,
+                      DecodedCandidates &out,
+                      const std::vector<int> *activeClasses) const;
+
+    // Emit a candidate for anchor `anchor` of a channel-major YOLOv8 tensor
+    void emitYoloV8(const float *data, int anchor, float maxScore,
+                    const LetterboxInfo &info, DecodedCandidates &out,
+                    const std::vector<int> *activeClasses) const;
+
+    Layout layout{Layout::YoloV8};
+    int numAnchors{0};
+    int numClasses{0};
+    int dimensions{0};
+
+    Kernel kernel{nullptr};
+    const char *kernelName{"none"};
+};
+
+#endif // YOLODECODER_H
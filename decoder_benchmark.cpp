@@ -0,0 +1,182 @@
+// Micro-benchmark: legacy transpose + minMaxLoc decode vs. YoloDecoder
+//
+// Usage:
+//   Yolov8DecoderBenchmark --record <model.onnx> <image> <tensor.yml.gz>
+//       Run the model once on an image and store the raw output tensor.
+//   Yolov8DecoderBenchmark [--iterations N] [--threshold T] <tensor.yml.gz> [...]
+//       Decode each recorded tensor with both paths and compare timings.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+
+#include "YoloDecoder.h"
+
+namespace {
+
+// Decode path as it was in Inference::runInference before YoloDecoder
+void decodeLegacy(const cv::Mat &output, float scoreThreshold, const LetterboxInfo &info,
+                  DecodedCandidates &out)
+{
+    // Only yolov8 tensors reach this path (checked by the caller)
+    int rows = output.size[2];
+    int dimensions = output.size[1];
+
+    cv::Mat data2d = output.reshape(1, dimensions);
+    cv::transpose(data2d, data2d);
+    float *data = (float *)data2d.data;
+    int num_classes = dimensions - 4;
+
+    for (int i = 0; i < rows; ++i)
+    {
+        cv::Mat scores(1, num_classes, CV_32FC1, data + 4);
+        cv::Point class_id;
+        double maxClassScore;
+        cv::minMaxLoc(scores, 0, &maxClassScore, 0, &class_id);
+
+        if (maxClassScore > scoreThreshold)
+        {
+            out.confidences.push_back(maxClassScore);
+            out.class_ids.push_back(class_id.x);
+
+            int left = int((data[0] - 0.5 * data[2] - info.pad_x) / info.scale);
+            int top = int((data[1] - 0.5 * data[3] - info.pad_y) / info.scale);
+            out.boxes.push_back(cv::Rect(left, top, int(data[2] / info.scale), int(data[3] / info.scale)));
+        }
+        data += dimensions;
+    }
+}
+
+template <typename Fn>
+double medianMicroseconds(int iterations, Fn &&fn)
+{
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int recordTensor(const std::string &modelPath, const std::string &imagePath, const std::string &outPath)
+{
+    cv::dnn::Net net = cv::dnn::readNetFromONNX(modelPath);
+    cv::Mat image = cv::imread(imagePath);
+    if (image.empty())
+    {
+        std::cerr << "Error: cannot read image " << imagePath << std::endl;
+        return -1;
+    }
+
+    cv::Mat blob;
+    cv::dnn::blobFromImage(image, blob, 1.0 / 255.0, cv::Size(640, 640), cv::Scalar(), true, false);
+    net.setInput(blob);
+
+    std::vector<cv::Mat> outputs;
+    net.forward(outputs, net.getUnconnectedOutLayersNames());
+
+    cv::FileStorage fs(outPath, cv::FileStorage::WRITE);
+    fs << "output" << outputs[0];
+    fs.release();
+
+    std::cout << "Recorded output tensor to " << outPath << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc >= 5 && std::string(argv[1]) == "--record")
+        return recordTensor(argv[2], argv[3], argv[4]);
+
+    int iterations = 200;
+    float scoreThreshold = 0.45f;
+    std::vector<std::string> tensorFiles;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc)
+            iterations = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--threshold" && i + 1 < argc)
+            scoreThreshold = std::stof(argv[++i]);
+        else
+            tensorFiles.push_back(arg);
+    }
+
+    if (tensorFiles.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " [--iterations N] [--threshold T] <tensor.yml.gz> [...]" << std::endl;
+        std::cerr << "       " << argv[0] << " --record <model.onnx> <image> <tensor.yml.gz>" << std::endl;
+        return -1;
+    }
+
+    LetterboxInfo info;
+
+    for (const auto &path : tensorFiles)
+    {
+        cv::Mat output;
+        cv::FileStorage fs(path, cv::FileStorage::READ);
+        if (!fs.isOpened())
+        {
+            std::cerr << "Skipping " << path << ": cannot open" << std::endl;
+            continue;
+        }
+        fs["output"] >> output;
+        fs.release();
+
+        if (output.empty() || output.dims != 3)
+        {
+            std::cerr << "Skipping " << path << ": expected a 3-D output tensor" << std::endl;
+            continue;
+        }
+
+        YoloDecoder decoder;
+        decoder.configure(output.size[1], output.size[2]);
+        if (decoder.getLayout() != YoloDecoder::Layout::YoloV8)
+        {
+            std::cerr << "Skipping " << path << ": only YOLOv8 tensors are benchmarked" << std::endl;
+            continue;
+        }
+
+        DecodedCandidates legacy, scalar, simd;
+
+        double legacyUs = medianMicroseconds(iterations, [&]() {
+            legacy.clear();
+            decodeLegacy(output, scoreThreshold, info, legacy);
+        });
+        double scalarUs = medianMicroseconds(iterations, [&]() {
+            scalar.clear();
+            decoder.decodeYoloV8Scalar(output.ptr<float>(0), info, scoreThreshold, scalar);
+        });
+        double simdUs = medianMicroseconds(iterations, [&]() {
+            simd.clear();
+            decoder.decode(output.ptr<float>(0), info, 0.0f, scoreThreshold, simd);
+        });
+
+        bool match = legacy.class_ids == simd.class_ids && legacy.class_ids == scalar.class_ids &&
+                     legacy.boxes.size() == simd.boxes.size();
+
+        std::cout << path << " (" << decoder.getNumClasses() << " classes x "
+                  << decoder.getNumAnchors() << " anchors, " << simd.boxes.size() << " candidates, kernel "
+                  << decoder.getKernelName() << ")" << std::endl;
+        std::cout << "  legacy transpose+minMaxLoc: " << legacyUs << " us" << std::endl;
+        std::cout << "  decoder scalar:             " << scalarUs << " us" << std::endl;
+        std::cout << "  decoder SIMD:               " << simdUs << " us"
+                  << "  (x" << (simdUs > 0 ? legacyUs / simdUs : 0.0) << ")" << std::endl;
+        std::cout << "  results " << (match ? "match" : "DIFFER") << std::endl;
+    }
+
+    return 0;
+}
@@ -1,11 +1,16 @@
 // Ultralytics 🚀 AGPL-3.0 License - https://ultralytics.com/license
 
 #include "inference.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
 
 Inference::Inference(const std::string &onnxModelPath, const cv::Size &modelInputShape, const std::string &classesTxtFile, const bool &runWithCuda)
 {
     modelPath = onnxModelPath;
     modelShape = modelInputShape;
+    preprocessor.setInputShape(modelInputShape);
     classesPath = classesTxtFile;
     cudaEnabled = runWithCuda;
 
@@ -23,154 +28,304 @@ Inference::Inference(const std::string &onnxModelPath, const cv::Size &modelInpu
     }
 }
 
+Inference::Inference(const std::vector<uchar> &onnxModelBuffer, const std::vector<std::string> &classNames, const cv::Size &modelInputShape, const BackendOptions &backendOptions)
+{
+    modelShape = modelInputShape;
+    preprocessor.setInputShape(modelInputShape);
+    cudaEnabled = backendOptions.useCuda;
+    classes = classNames;
+
+    backend = createDetectorBackend(onnxModelBuffer, backendOptions);
+}
+
 std::vector<Detection> Inference::runInference(const cv::Mat &input)
 {
-    cv::Mat modelInput = input;
-    int pad_x, pad_y;
-    float scale;
-    if (letterBoxForSquare && modelShape.width == modelShape.height)
-        modelInput = formatToSquare(modelInput, &pad_x, &pad_y, &scale);
+    std::vector<Detection> detections;
+    runInference(input, detections);
+    return detections;
+}
 
-    cv::Mat blob;
-    cv::dnn::blobFromImage(modelInput, blob, 1.0/255.0, modelShape, cv::Scalar(), true, false);
-    net.setInput(blob);
+void Inference::runInference(const cv::Mat &input, std::vector<Detection> &detections)
+{
+    TilingConfig tiling = getTiling();
+    if (tiling.enabled)
+    {
+        runInferenceTiled(input, tiling, detections);
+        return;
+    }
 
-    std::vector<cv::Mat> outputs;
-    net.forward(outputs, net.getUnconnectedOutLayersNames());
+    detections.clear();
+    detectSingle(input, detections);
+}
 
-    int rows = outputs[0].size[1];
-    int dimensions = outputs[0].size[2];
+void Inference::detectSingle(const cv::Mat &input, std::vector<Detection> &detections)
+{
+    // The backend output may alias runtime memory, so decode before releasing the lock
+    std::lock_guard<std::mutex> lock(netMutex);
+    cv::Mat blob = preprocessor.getBlob(1);
+    LetterboxInfo info = preprocessor.process(input, blob, 0);
 
-    bool yolov8 = false;
-    // yolov5 has an output of shape (batchSize, 25200, 85) (Num classes + box[x,y,w,h] + confidence[c])
-    // yolov8 has an output of shape (batchSize, 84,  8400) (Num classes + box[x,y,w,h])
-    if (dimensions > rows) // Check if the shape[2] is more than shape[1] (yolov8)
-    {
-        yolov8 = true;
-        rows = outputs[0].size[2];
-        dimensions = outputs[0].size[1];
+    cv::Mat output = backend->forward(blob);
+    decodeBatchEntry(output, 0, info, detections);
+}
 
-        outputs[0] = outputs[0].reshape(1, dimensions);
-        cv::transpose(outputs[0], outputs[0]);
-    }
-    float *data = (float *)outputs[0].data;
+void Inference::warmUp(int passes)
+{
+    if (passes <= 0)
+        return;
 
-    std::vector<int> class_ids;
-    std::vector<float> confidences;
-    std::vector<cv::Rect> boxes;
+    // The first forward pass allocates layer buffers and finalizes the graph;
+    // later passes settle the backend's internal thread pool
+    cv::Mat dummy = cv::Mat::zeros(cv::Size(static_cast<int>(modelShape.width), static_cast<int>(modelShape.height)), CV_8UC3);
 
-    // Calculate dynamic class count from model output
-    int num_classes = yolov8 ? (dimensions - 4) : (dimensions - 5);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i)
+        runInference(dummy);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
 
-    // Auto-generate class names if not loaded or mismatch
-    static bool classes_initialized = false;
-    if (!classes_initialized) {
-        if (classes.empty() || num_classes != static_cast<int>(classes.size())) {
-            if (!classes.empty()) {
-                std::cout << "⚠️  WARNING: Model has " << num_classes << " classes, but "
-                         << classes.size() << " class names are defined." << std::endl;
-            }
-            std::cout << "📝 Generating default class names for " << num_classes << " classes..." << std::endl;
-            generateDefaultClassNames(num_classes);
-        }
-        classes_initialized = true;
+    std::cout << "🔥 Warm-up: " << passes << " pass(es) in " << elapsed.count() << " ms" << std::endl;
+}
+
+std::vector<std::vector<Detection>> Inference::runInferenceBatch(const std::vector<cv::Mat> &inputs)
+{
+    TilingConfig tiling = getTiling();
+    if (!tiling.enabled)
+        return detectBatch(inputs);
+
+    // Each frame already fills a batch with its own tiles
+    std::vector<std::vector<Detection>> results(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+        runInferenceTiled(inputs[i], tiling, results[i]);
+
+    return results;
+}
+
+void Inference::runInferenceTiled(const cv::Mat &input, const TilingConfig &config, std::vector<Detection> &detections)
+{
+    detections.clear();
+
+    std::vector<cv::Rect> tiles = computeTiles(input.size(), config);
+
+    std::vector<cv::Mat> crops;
+    crops.reserve(tiles.size() + 1);
+    for (const cv::Rect &tile : tiles)
+        crops.push_back(input(tile));
+    if (config.includeFullFrame && tiles.size() > 1)
+    {
+        crops.push_back(input);
+        tiles.push_back(cv::Rect(0, 0, input.cols, input.rows));
     }
 
-    for (int i = 0; i < rows; ++i)
+    // All tiles go through a single forward pass
+    std::vector<std::vector<Detection>> perTile = detectBatch(crops);
+
+    std::vector<Detection> merged;
+    DecodedCandidates tileCandidates;
+    for (size_t t = 0; t < perTile.size(); ++t)
     {
-        if (yolov8)
+        for (Detection &det : perTile[t])
         {
-            float *classes_scores = data+4;
+            det.box.x += tiles[t].x;
+            det.box.y += tiles[t].y;
 
-            cv::Mat scores(1, num_classes, CV_32FC1, classes_scores);
-            cv::Point class_id;
-            double maxClassScore;
+            tileCandidates.class_ids.push_back(det.class_id);
+            tileCandidates.confidences.push_back(det.confidence);
+            tileCandidates.boxes.push_back(det.box);
+            merged.push_back(det);
+        }
+    }
 
-            minMaxLoc(scores, 0, &maxClassScore, 0, &class_id);
+    if (tiles.size() <= 1)
+    {
+        detections.insert(detections.end(), merged.begin(), merged.end());
+        return;
+    }
 
-            if (maxClassScore > modelScoreThreshold)
-            {
-                confidences.push_back(maxClassScore);
-                class_ids.push_back(class_id.x);
+    // Cross-tile NMS; IoS also merges the clipped copy of an object cut by a tile seam
+    NmsParams nmsParams;
+    nmsParams.scoreThreshold = 0.0f;
+    nmsParams.iouThreshold = modelNMSThreshold;
+    nmsParams.iosThreshold = config.seamMergeThreshold;
+    nmsParams.classAware = true;
+    nmsParams.topK = maxDetections.load(std::memory_order_relaxed);
 
-                float x = data[0];
-                float y = data[1];
-                float w = data[2];
-                float h = data[3];
+    std::vector<int> keep;
+    nonMaxSuppression(tileCandidates, nmsParams, keep);
 
-                int left = int((x - 0.5 * w - pad_x) / scale);
-                int top = int((y - 0.5 * h - pad_y) / scale);
+    for (int idx : keep)
+        detections.push_back(merged[idx]);
+}
 
-                int width = int(w / scale);
-                int height = int(h / scale);
+std::vector<cv::Rect> Inference::computeTiles(const cv::Size &frameSize, const TilingConfig &config)
+{
+    const int tileSize = std::max(32, config.tileSize);
+    const int step = std::max(1, static_cast<int>(tileSize * (1.0f - std::clamp(config.overlap, 0.0f, 0.9f))));
 
-                boxes.push_back(cv::Rect(left, top, width, height));
-            }
+    // Start offsets along one axis; the last tile is aligned to the frame edge
+    auto offsets = [&](int length) {
+        std::vector<int> result;
+        if (length <= tileSize)
+        {
+            result.push_back(0);
+            return result;
         }
-        else // yolov5
+        for (int pos = 0; pos + tileSize < length; pos += step)
+            result.push_back(pos);
+        result.push_back(length - tileSize);
+        return result;
+    };
+
+    std::vector<cv::Rect> tiles;
+    for (int y : offsets(frameSize.height))
+    {
+        for (int x : offsets(frameSize.width))
         {
-            float confidence = data[4];
-
-            if (confidence >= modelConfidenceThreshold)
-            {
-                float *classes_scores = data+5;
+            tiles.push_back(cv::Rect(x, y,
+                                     std::min(tileSize, frameSize.width),
+                                     std::min(tileSize, frameSize.height)));
+        }
+    }
 
-                cv::Mat scores(1, num_classes, CV_32FC1, classes_scores);
-                cv::Point class_id;
-                double max_class_score;
+    return tiles;
+}
 
-                minMaxLoc(scores, 0, &max_class_score, 0, &class_id);
+void Inference::setTiling(const TilingConfig &config)
+{
+    std::lock_guard<std::mutex> lock(tilingMutex);
+    tiling = config;
+}
 
-                if (max_class_score > modelScoreThreshold)
-                {
-                    confidences.push_back(confidence);
-                    class_ids.push_back(class_id.x);
+TilingConfig Inference::getTiling()
+{
+    std::lock_guard<std::mutex> lock(tilingMutex);
+    return tiling;
+}
 
-                    float x = data[0];
-                    float y = data[1];
-                    float w = data[2];
-                    float h = data[3];
+std::vector<std::vector<Detection>> Inference::detectBatch(const std::vector<cv::Mat> &inputs)
+{
+    std::vector<std::vector<Detection>> results(inputs.size());
+    if (inputs.empty())
+        return results;
 
-                    int left = int((x - 0.5 * w - pad_x) / scale);
-                    int top = int((y - 0.5 * h - pad_y) / scale);
+    if (inputs.size() > 1 && batchSupported.load(std::memory_order_acquire))
+    {
+        std::vector<LetterboxInfo> infos(inputs.size());
+        cv::Mat output;
 
-                    int width = int(w / scale);
-                    int height = int(h / scale);
+        std::lock_guard<std::mutex> lock(netMutex);
+        try
+        {
+            cv::Mat blob = preprocessor.getBlob(static_cast<int>(inputs.size()));
+            for (size_t i = 0; i < inputs.size(); ++i)
+                infos[i] = preprocessor.process(inputs[i], blob, static_cast<int>(i));
 
-                    boxes.push_back(cv::Rect(left, top, width, height));
-                }
-            }
+            output = backend->forward(blob);
+        }
+        catch (const std::exception &e)
+        {
+            // ONNX exports with a fixed batch dimension of 1 cannot take a stacked blob
+            std::cout << "⚠️  Model rejected batch of " << inputs.size()
+                      << ", falling back to per-frame inference: " << e.what() << std::endl;
+            batchSupported.store(false, std::memory_order_release);
         }
 
-        data += dimensions;
+        if (batchSupported.load(std::memory_order_acquire) && !output.empty() && output.size[0] == static_cast<int>(inputs.size()))
+        {
+            for (size_t i = 0; i < inputs.size(); ++i)
+                decodeBatchEntry(output, static_cast<int>(i), infos[i], results[i]);
+            return results;
+        }
     }
 
-    std::vector<int> nms_result;
-    cv::dnn::NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
+    // Batch of one, or model without dynamic batch support
+    for (size_t i = 0; i < inputs.size(); ++i)
+        detectSingle(inputs[i], results[i]);
+
+    return results;
+}
+
+void Inference::decodeBatchEntry(const cv::Mat &output, int batchIndex, const LetterboxInfo &info, std::vector<Detection> &detections)
+{
+    // The decoder reads the tensor in place (channel-major for yolov8), so no transpose is needed
+    configureDecoder(output);
 
-    std::vector<Detection> detections{};
-    for (unsigned long i = 0; i < nms_result.size(); ++i)
+    std::shared_ptr<const std::vector<int>> active;
     {
-        int idx = nms_result[i];
+        std::lock_guard<std::mutex> lock(activeClassesMutex);
+        active = activeClasses;
+    }
 
-        Detection result;
-        result.class_id = class_ids[idx];
-        result.confidence = confidences[idx];
+    candidates.clear();
+    decoder.decode(output.ptr<float>(batchIndex), info, modelConfidenceThreshold, modelScoreThreshold,
+                   candidates, active.get());
+
+    buildDetections(candidates, detections);
+}
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<int> dis(100, 255);
-        result.color = cv::Scalar(dis(gen),
-                                  dis(gen),
-                                  dis(gen));
+void Inference::setActiveClasses(const std::set<int> &classIds)
+{
+    std::shared_ptr<const std::vector<int>> active;
+    if (!classIds.empty())
+        active = std::make_shared<const std::vector<int>>(classIds.begin(), classIds.end());
 
-        result.className = classes[result.class_id];
-        result.box = boxes[idx];
+    std::lock_guard<std::mutex> lock(activeClassesMutex);
+    activeClasses = active;
+}
 
-        detections.push_back(result);
+void Inference::setMaxDetections(int maxCount)
+{
+    maxDetections.store(std::max(0, maxCount), std::memory_order_relaxed);
+}
+
+void Inference::configureDecoder(const cv::Mat &output)
+{
+    // Layout, class count and kernel come from the first output (normally the warm-up pass)
+    if (decoder.isConfiguredFor(output.size[1], output.size[2]))
+        return;
+
+    decoder.configure(output.size[1], output.size[2]);
+    initializeClassNames(decoder.getNumClasses());
+
+    std::cout << "🧩 Decoder kernel: " << decoder.getKernelName()
+              << " (" << decoder.getNumAnchors() << " anchors)" << std::endl;
+}
+
+void Inference::initializeClassNames(int num_classes)
+{
+    // Auto-generate class names if not loaded or mismatch
+    if (!classesInitialized) {
+        if (classes.empty() || num_classes != static_cast<int>(classes.size())) {
+            if (!classes.empty()) {
+                std::cout << "⚠️  WARNING: Model has " << num_classes << " classes, but "
+                         << classes.size() << " class names are defined." << std::endl;
+            }
+            std::cout << "📝 Generating default class names for " << num_classes << " classes..." << std::endl;
+            generateDefaultClassNames(num_classes);
+        }
+        classesInitialized = true;
     }
+}
 
-    return detections;
+void Inference::buildDetections(const DecodedCandidates &decoded, std::vector<Detection> &detections)
+{
+    // Per-class suppression: overlapping objects of different classes are both kept
+    NmsParams nmsParams;
+    nmsParams.scoreThreshold = modelScoreThreshold;
+    nmsParams.iouThreshold = modelNMSThreshold;
+    nmsParams.classAware = true;
+    nmsParams.topK = maxDetections.load(std::memory_order_relaxed);
+
+    nonMaxSuppression(decoded, nmsParams, nmsKeep);
+
+    detections.reserve(detections.size() + nmsKeep.size());
+    for (int idx : nmsKeep)
+    {
+        Detection result;
+        result.class_id = decoded.class_ids[idx];
+        result.confidence = decoded.confidences[idx];
+        result.box = decoded.boxes[idx];
+        detections.push_back(result);
+    }
 }
 
 void Inference::loadClassesFromFile()
@@ -179,21 +334,32 @@ void Inference::loadClassesFromFile()
         return;
     }
 
-    std::ifstream inputFile(classesPath);
+    std::vector<std::string> fileClasses = readClassNames(classesPath);
+    if (!fileClasses.empty()) {
+        classes = fileClasses;
+    }
+}
+
+std::vector<std::string> Inference::readClassNames(const std::string &classesTxtFile)
+{
+    std::vector<std::string> names;
+
+    std::ifstream inputFile(classesTxtFile);
     if (inputFile.is_open())
     {
-        classes.clear();  // Clear existing classes
         std::string classLine;
         while (std::getline(inputFile, classLine))
         {
             // Trim whitespace
             classLine.erase(classLine.find_last_not_of(" \n\r\t") + 1);
             if (!classLine.empty()) {
-                classes.push_back(classLine);
+                names.push_back(classLine);
             }
         }
         inputFile.close();
     }
+
+    return names;
 }
 
 void Inference::generateDefaultClassNames(int numClasses)
@@ -205,21 +371,20 @@ void Inference::generateDefaultClassNames(int numClasses)
     std::cout << "   Generated default names: class_0 to class_" << (numClasses - 1) << std::endl;
 }
 
+std::vector<uchar> Inference::readModelFile(const std::string &onnxModelPath)
+{
+    std::ifstream file(onnxModelPath, std::ios::binary);
+    if (!file.is_open())
+        throw std::runtime_error("Cannot open model file: " + onnxModelPath);
+
+    return std::vector<uchar>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
 void Inference::loadOnnxNetwork()
 {
-    net = cv::dnn::readNetFromONNX(modelPath);
-    if (cudaEnabled)
-    {
-        std::cout << "\nRunning on CUDA" << std::endl;
-        net.setPreferableBackend(cv::dnn::DNN_BACKEND_CUDA);
-        net.setPreferableTarget(cv::dnn::DNN_TARGET_CUDA);
-    }
-    else
-    {
-        std::cout << "\nRunning on CPU" << std::endl;
-        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
-        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-    }
+    BackendOptions options;
+    options.useCuda = cudaEnabled;
+    backend = createDetectorBackend(readModelFile(modelPath), options);
 }
 
 std::string Inference::getClassName(int class_id) const
@@ -231,24 +396,3 @@ std::string Inference::getClassName(int class_id) const
     // Return generic class name for out-of-range indices
     return "class_" + std::to_string(class_id);
 }
-
-cv::Mat Inference::formatToSquare(const cv::Mat &source, int *pad_x, int *pad_y, float *scale)
-{
-    int col = source.cols;
-    int row = source.rows;
-    int m_inputWidth = modelShape.width;
-    int m_inputHeight = modelShape.height;
-
-    *scale = std::min(m_inputWidth / (float)col, m_inputHeight / (float)row);
-    int resized_w = col * *scale;
-    int resized_h = row * *scale;
-    *pad_x = (m_inputWidth - resized_w) / 2;
-    *pad_y = (m_inputHeight - resized_h) / 2;
-
-    cv::Mat resized;
-    cv::resize(source, resized, cv::Size(resized_w, resized_h));
-    cv::Mat result = cv::Mat::zeros(m_inputHeight, m_inputWidth, source.type());
-    resized.copyTo(result(cv::Rect(*pad_x, *pad_y, resized_w, resized_h)));
-    resized.release();
-    return result;
-}
\ No newline at end of file
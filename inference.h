@@ -7,28 +7,75 @@
 #include <fstream>
 #include <vector>
 #include <string>
-#include <random>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <set>
 
 // OpenCV / DNN / Inference
 #include <opencv2/imgproc.hpp>
 #include <opencv2/opencv.hpp>
 #include <opencv2/dnn.hpp>
 
+#include "InferenceTypes.h"
+#include "YoloDecoder.h"
+#include "Nms.h"
+#include "LetterboxPreprocessor.h"
+#include "DetectorBackend.h"
+
+// Compact result (24 bytes, no heap members); resolve the class name with Inference::getClassName
 struct Detection
 {
     int class_id{0};
-    std::string className{};
-    float confidence{0.0};
-    cv::Scalar color{};
-    cv::Rect box{};
+    float confidence{0.0f};
+    cv::Rect box{};  // Source-frame pixels
 };
 
 class Inference
 {
 public:
     Inference(const std::string &onnxModelPath, const cv::Size &modelInputShape = {640, 640}, const std::string &classesTxtFile = "", const bool &runWithCuda = true);
+
+    // Build from a model already read into memory, so several instances can share one load (see InferencePool)
+    Inference(const std::vector<uchar> &onnxModelBuffer, const std::vector<std::string> &classNames, const cv::Size &modelInputShape = {640, 640}, const BackendOptions &backendOptions = {});
     std::vector<Detection> runInference(const cv::Mat &input);
 
+    // Same as above into a caller-owned buffer; it is cleared, not reallocated, so a
+    // buffer reused across frames stops allocating once it has reached peak size
+    void runInference(const cv::Mat &input, std::vector<Detection> &detections);
+
+    // Run `passes` forward passes on a blank frame so the first real frame does not
+    // pay for lazy graph initialization (also resolves the class list from the output shape)
+    void warmUp(int passes);
+
+    // Run several frames through a single forward pass (NCHW blob, batch = inputs.size()).
+    // Results are returned in the same order as the inputs.
+    std::vector<std::vector<Detection>> runInferenceBatch(const std::vector<cv::Mat> &inputs);
+
+    // Split a large frame into overlapping tiles (plus optionally the full frame), detect
+    // on all of them in one batched forward pass and merge the results with cross-tile NMS
+    void runInferenceTiled(const cv::Mat &input, const TilingConfig &config, std::vector<Detection> &detections);
+
+    // Tiling used by runInference / runInferenceBatch (disabled by default)
+    void setTiling(const TilingConfig &config);
+    TilingConfig getTiling();
+
+    // Tile rectangles covering a frame of the given size
+    static std::vector<cv::Rect> computeTiles(const cv::Size &frameSize, const TilingConfig &config);
+
+    // Restrict decoding to these class ids (empty set = all classes).
+    // Channels of other classes are never scored, so they cost no argmax or NMS work.
+    void setActiveClasses(const std::set<int> &classIds);
+
+    // Cap the number of detections per frame after NMS (0 = no cap)
+    void setMaxDetections(int maxCount);
+
+    // Runtime executing the model (OpenCV DNN, ONNX Runtime, ...)
+    std::string getBackendName() const { return backend->getName(); }
+
+    // Precision of the loaded model (FP32, FP16 or INT8/QDQ)
+    ModelPrecision getPrecision() const { return backend->getPrecision(); }
+
     // Get class name by class ID
     std::string getClassName(int class_id) const;
 
@@ -36,11 +83,26 @@ public:
     const std::vector<std::string>& getAllClasses() const { return classes; }
     int getClassCount() const { return static_cast<int>(classes.size()); }
 
+    // Read one class name per line (empty vector if the file is missing)
+    static std::vector<std::string> readClassNames(const std::string &classesTxtFile);
+
+    // Read a whole model file into memory
+    // @throws std::runtime_error if the file cannot be opened
+    static std::vector<uchar> readModelFile(const std::string &onnxModelPath);
+
 private:
+    // These append to `detections`
+    void detectSingle(const cv::Mat &input, std::vector<Detection> &detections);
+    void decodeBatchEntry(const cv::Mat &output, int batchIndex, const LetterboxInfo &info, std::vector<Detection> &detections);
+    void buildDetections(const DecodedCandidates &decoded, std::vector<Detection> &detections);
+
+    std::vector<std::vector<Detection>> detectBatch(const std::vector<cv::Mat> &inputs);
+    void configureDecoder(const cv::Mat &output);
+    void initializeClassNames(int num_classes);
+
     void loadClassesFromFile();
     void loadOnnxNetwork();
     void generateDefaultClassNames(int numClasses);
-    cv::Mat formatToSquare(const cv::Mat &source, int *pad_x, int *pad_y, float *scale);
 
     std::string modelPath{};
     std::string classesPath{};
@@ -48,16 +110,43 @@ private:
 
     // Dynamic class list - loaded from file or generated from model
     std::vector<std::string> classes;
+    bool classesInitialized{false};  // Per instance: pooled instances each check their own model output
 
     cv::Size2f modelShape{};
 
+    // Per-model metadata (layout, class count, anchors) and the decode kernel chosen for it;
+    // configured from the first output under netMutex
+    YoloDecoder decoder;
+
+    // Decode/NMS scratch, reused under netMutex
+    DecodedCandidates candidates;
+    std::vector<int> nmsKeep;
+
+    // Sorted active class ids (nullptr = all); swapped as a whole so a decode in
+    // flight keeps the snapshot it started with
+    std::shared_ptr<const std::vector<int>> activeClasses;
+    std::mutex activeClassesMutex;
+
+    TilingConfig tiling;
+    std::mutex tilingMutex;
+
     float modelConfidenceThreshold {0.25};
     float modelScoreThreshold      {0.45};
     float modelNMSThreshold        {0.50};
+    std::atomic<int> maxDetections {0};
+
+    // Letterboxes frames straight into a reusable input blob
+    LetterboxPreprocessor preprocessor;
+
+    std::unique_ptr<DetectorBackend> backend;
 
-    bool letterBoxForSquare = true;
+    // Backends are not thread-safe; serializes forward passes, use of the
+    // preprocessor's shared blob and decoding of the backend's output
+    std::mutex netMutex;
 
-    cv::dnn::Net net;
+    // Cleared when the model rejects a batch > 1 (static batch ONNX export);
+    // read before taking netMutex, so atomic
+    std::atomic<bool> batchSupported{true};
 };
 
-#endif // INFERENCE_H
\ No newline at end of file
+#endif // INFERENCE_H
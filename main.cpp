@@ -39,6 +39,8 @@ int main(int argc, char **argv)
     std::map<size_t, int> track_class_map;
 
     cv::Mat frame;
+    std::vector<Detection> detections;
+    std::vector<byte_track::Object> objects;
     while (true)
     {
         // Capture frame from webcam
@@ -51,10 +53,10 @@ int main(int argc, char **argv)
         }
 
         // YOLO Detection
-        std::vector<Detection> detections = inf.runInference(frame);
+        inf.runInference(frame, detections);
 
         // Convert YOLO detections to ByteTrack objects
-        std::vector<byte_track::Object> objects = convertToByteTrackObjects(detections);
+        convertToByteTrackObjects(detections, objects);
 
         // Update tracker with new detections
         std::vector<byte_track::BYTETracker::STrackPtr> tracks = tracker.update(objects);
@@ -158,4 +160,4 @@ int main(int argc, char **argv)
 
     std::cout << "Inference stopped." << std::endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -1,11 +1,252 @@
 // YOLOv8 Multi-Camera Tracking System with Qt GUI
 
 #include <QApplication>
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QSettings>
 #include "MainWindow.h"
+#include "CameraManager.h"
+#include "OfflineProcessor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+
+// Regions saved next to a camera configuration (MainWindow::onSaveConfiguration)
+std::map<int, std::vector<Region>> loadRegions(const std::string& configPath) {
+    std::map<int, std::vector<Region>> regionsByCamera;
+
+    std::string regionsPath = configPath;
+    size_t dotPos = regionsPath.find_last_of('.');
+    if (dotPos != std::string::npos) {
+        regionsPath.insert(dotPos, "_regions");
+    } else {
+        regionsPath += "_regions.json";
+    }
+
+    std::ifstream regionsFile(regionsPath);
+    if (!regionsFile.is_open()) {
+        return regionsByCamera;
+    }
+
+    try {
+        json regionsJson;
+        regionsFile >> regionsJson;
+        if (regionsJson.contains("regions")) {
+            for (const auto& cameraRegions : regionsJson["regions"]) {
+                std::vector<Region>& regions = regionsByCamera[cameraRegions["camera_id"].get<int>()];
+                if (cameraRegions.contains("regions")) {
+                    for (const auto& regionJson : cameraRegions["regions"]) {
+                        regions.push_back(Region::fromJson(regionJson));
+                    }
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "⚠️  Invalid regions file " << regionsPath << ": " << e.what() << std::endl;
+    }
+    return regionsByCamera;
+}
+
+void printOfflineUsage(const char* program) {
+    std::cerr << "Usage: " << program << " --offline [--output <dir>] [--jobs N] [--config cameras_config.json]"
+              << " [--model <model.onnx>] [--count-classes 0,2,...] [video ...]" << std::endl;
+}
+
+// Whole-string integer parse; false on anything std::stoi would reject or only partly read
+bool parseInt(const std::string& text, int& value) {
+    try {
+        size_t used = 0;
+        value = std::stoi(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * Offline mode: count recorded video files as fast as the hardware allows.
+ *
+ *   Yolov8MultiCameraGUI --offline [--output <dir>] [--jobs N] [--config cameras_config.json]
+ *                        [--model <model.onnx>] [--count-classes 0,2,...] [video ...]
+ *
+ * Without video arguments every VIDEO_FILE camera of the configuration is
+ * processed. A file that matches a configured camera's source uses that
+ * camera's name and regions.
+ */
+int runOffline(int argc, char* argv[]) {
+    QSettings settings("YOLOTracking", "Yolov8CameraGUI");
+
+    OfflineProcessor::Options options;
+    options.jobs = InferencePool::defaultPoolSize();
+    options.roiInference = settings.value("Inference/RoiEnabled", false).toBool();
+    options.roiMarginRatio = settings.value("Inference/RoiMargin", 0.15).toFloat();
+
+    std::string configPath = "cameras_config.json";
+    std::string modelPath = settings.value("Model/Path", "yolov8n.onnx").toString().toStdString();
+    std::vector<std::string> videos;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--offline") {
+            continue;
+        } else if (arg == "--output" && hasValue) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--jobs" && hasValue) {
+            int jobs = 0;
+            if (!parseInt(argv[++i], jobs) || jobs < 1) {
+                std::cerr << "❌ --jobs expects a positive number, got '" << argv[i] << "'" << std::endl;
+                printOfflineUsage(argv[0]);
+                return -1;
+            }
+            options.jobs = jobs;
+        } else if (arg == "--config" && hasValue) {
+            configPath = argv[++i];
+        } else if (arg == "--model" && hasValue) {
+            modelPath = argv[++i];
+        } else if (arg == "--count-classes" && hasValue) {
+            std::stringstream list(argv[++i]);
+            for (std::string id; std::getline(list, id, ',');) {
+                int classId = 0;
+                if (!parseInt(id, classId) || classId < 0) {
+                    std::cerr << "❌ --count-classes expects class IDs like 0,2,3, got '" << argv[i] << "'" << std::endl;
+                    printOfflineUsage(argv[0]);
+                    return -1;
+                }
+                options.countClasses.insert(classId);
+            }
+        } else if (arg.rfind("--", 0) == 0) {
+            // Unknown option, or a known one without its value; not a video file
+            std::cerr << "❌ Invalid option '" << arg << "'" << std::endl;
+            printOfflineUsage(argv[0]);
+            return -1;
+        } else {
+            videos.push_back(arg);
+        }
+    }
+
+    CameraManager cameraManager;
+    std::map<int, std::vector<Region>> regionsByCamera;
+    if (QFileInfo::exists(QString::fromStdString(configPath))) {
+        cameraManager.loadFromFile(configPath);
+        regionsByCamera = loadRegions(configPath);
+    }
+
+    std::vector<OfflineProcessor::Job> jobs;
+    auto addJob = [&](const std::string& path, const std::shared_ptr<CameraSource>& camera) {
+        OfflineProcessor::Job job;
+        job.videoPath = path;
+        if (camera) {
+            job.cameraName = camera->getName();
+            job.cameraId = camera->getId();
+            job.regions = regionsByCamera[camera->getId()];
+        } else {
+            job.cameraName = QFileInfo(QString::fromStdString(path)).completeBaseName().toStdString();
+        }
+        if (job.regions.empty()) {
+            std::cout << "⚠️  " << job.cameraName << ": no regions configured, no events will be recorded" << std::endl;
+        }
+        jobs.push_back(job);
+    };
+
+    if (videos.empty()) {
+        for (const auto& camera : cameraManager.getAllCameras()) {
+            if (camera->getType() == CameraType::VIDEO_FILE) {
+                addJob(camera->getSource(), camera);
+            }
+        }
+    } else {
+        for (const std::string& video : videos) {
+            std::shared_ptr<CameraSource> match;
+            for (const auto& camera : cameraManager.getAllCameras()) {
+                if (camera->getSource() == video) {
+                    match = camera;
+                    break;
+                }
+            }
+            addJob(video, match);
+        }
+    }
+
+    if (jobs.empty()) {
+        printOfflineUsage(argv[0]);
+        std::cerr << "No video files given and no VIDEO_FILE cameras in " << configPath << std::endl;
+        return -1;
+    }
+    options.jobs = std::min<int>(options.jobs, static_cast<int>(jobs.size()));
+
+    BackendOptions backendOptions;
+    backendOptions.type = backendTypeFromString(settings.value("Inference/Backend", "opencv").toString().toStdString());
+    backendOptions.intraOpThreads = settings.value("Inference/IntraOpThreads", 0).toInt();
+    backendOptions.interOpThreads = settings.value("Inference/InterOpThreads", 0).toInt();
+
+    // Split the cores across the parallel files instead of letting every forward pass use all of them
+    int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int threadsPerJob = std::max(1, cores / options.jobs);
+    cv::setNumThreads(threadsPerJob);
+    if (backendOptions.intraOpThreads <= 0) {
+        backendOptions.intraOpThreads = threadsPerJob;
+    }
+
+    TilingConfig tiling;
+    tiling.enabled = settings.value("Inference/TilingEnabled", false).toBool();
+    tiling.tileSize = settings.value("Inference/TileSize", 960).toInt();
+    tiling.overlap = settings.value("Inference/TileOverlap", 0.2).toFloat();
+    tiling.includeFullFrame = settings.value("Inference/TileFullFrame", true).toBool();
+
+    try {
+        // One instance per parallel file
+        auto pool = std::make_shared<InferencePool>(modelPath, cv::Size(640, 640), "classes.txt",
+                                                    backendOptions, options.jobs);
+        pool->setMaxDetections(settings.value("Inference/MaxDetections", 0).toInt());
+        pool->setTiling(tiling);
+        if (!options.countClasses.empty()) {
+            pool->setActiveClasses(options.countClasses);
+        }
+
+        std::cout << "🚀 Offline mode: " << jobs.size() << " file(s), " << options.jobs << " in parallel ("
+                  << threadsPerJob << " thread(s) each), output to " << options.outputDir << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        OfflineProcessor processor(pool, options);
+        std::vector<OfflineProcessor::Result> results = processor.run(jobs);
+        double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        OfflineProcessor::printSummary(results, wallSeconds);
+        for (const auto& result : results) {
+            if (!result.ok) {
+                return 1;
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+}  // namespace
 
 int main(int argc, char *argv[])
 {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--offline") == 0) {
+            // Headless: no display needed
+            QCoreApplication app(argc, argv);
+            return runOffline(argc, argv);
+        }
+    }
+
     QApplication app(argc, argv);
 
     // Set application info
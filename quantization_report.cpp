@@ -0,0 +1,308 @@
+// Accuracy/speed report: FP32 model vs. its quantized (INT8 QDQ) or FP16 export
+//
+// Usage:
+//   Yolov8QuantReport --fp32 <model.onnx> --quant <model_int8.onnx> --frames <dir>
+//                     [--backend opencv|onnxruntime] [--classes classes.txt]
+//                     [--iou 0.5] [--warmup 3]
+//
+// Both models run over every image in <dir>. The FP32 detections are used as
+// the reference, so "mAP" here measures how closely the quantized model
+// reproduces the FP32 model, not accuracy against ground truth.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+#include <algorithm>
+
+#include <opencv2/opencv.hpp>
+
+#include "inference.h"
+
+namespace {
+
+struct RunResult
+{
+    std::string precision;
+    std::vector<double> latenciesMs;
+    std::vector<std::vector<Detection>> detections;  // per frame
+};
+
+RunResult runModel(const std::string &modelPath, const std::vector<std::string> &classNames,
+                   const BackendOptions &options, const std::vector<cv::Mat> &frames, int warmupPasses)
+{
+    Inference inference(Inference::readModelFile(modelPath), classNames, cv::Size(640, 640), options);
+    inference.warmUp(warmupPasses);
+
+    RunResult result;
+    result.precision = modelPrecisionName(inference.getPrecision());
+    result.latenciesMs.reserve(frames.size());
+    result.detections.reserve(frames.size());
+
+    for (const cv::Mat &frame : frames)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        result.detections.push_back(inference.runInference(frame));
+        auto end = std::chrono::high_resolution_clock::now();
+        result.latenciesMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::cout << "  " << modelPath << ": " << inference.getBackendName() << ", " << result.precision << std::endl;
+    return result;
+}
+
+double percentile(std::vector<double> samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t index = static_cast<size_t>(p * (samples.size() - 1) + 0.5);
+    return samples[std::min(index, samples.size() - 1)];
+}
+
+double iou(const cv::Rect &a, const cv::Rect &b)
+{
+    double inter = (a & b).area();
+    double uni = a.area() + b.area() - inter;
+    return uni > 0 ? inter / uni : 0.0;
+}
+
+/**
+ * @brief Per-class AP of `candidate` against `reference` (VOC all-point interpolation)
+ * @param extraDetections Filled with class id -> box count for classes only `candidate` produced
+ * @return class id -> AP for every class with reference boxes; as in COCO/VOC, classes
+ *         without reference positives have no AP and stay out of the mean
+ */
+std::map<int, double> averagePrecision(const std::vector<std::vector<Detection>> &reference,
+                                       const std::vector<std::vector<Detection>> &candidate,
+                                       double iouThreshold,
+                                       std::map<int, int> &extraDetections)
+{
+    struct Scored
+    {
+        float confidence;
+        bool truePositive;
+    };
+    std::map<int, std::vector<Scored>> scoredByClass;
+    std::map<int, int> referenceCount;
+
+    for (size_t f = 0; f < reference.size(); ++f)
+    {
+        for (const Detection &ref : reference[f])
+            referenceCount[ref.class_id]++;
+
+        // Greedy matching in descending confidence, one candidate per reference box
+        std::vector<const Detection *> sorted;
+        for (const Detection &det : candidate[f])
+            sorted.push_back(&det);
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const Detection *a, const Detection *b) { return a->confidence > b->confidence; });
+
+        std::vector<bool> matched(reference[f].size(), false);
+        for (const Detection *det : sorted)
+        {
+            int best = -1;
+            double bestIou = iouThreshold;
+            for (size_t r = 0; r < reference[f].size(); ++r)
+            {
+                if (matched[r] || reference[f][r].class_id != det->class_id)
+                    continue;
+                double overlap = iou(det->box, reference[f][r].box);
+                if (overlap >= bestIou)
+                {
+                    bestIou = overlap;
+                    best = static_cast<int>(r);
+                }
+            }
+            if (best >= 0)
+                matched[best] = true;
+            scoredByClass[det->class_id].push_back({det->confidence, best >= 0});
+        }
+    }
+
+    std::map<int, double> apByClass;
+    for (const auto &entry : referenceCount)
+        apByClass[entry.first] = 0.0;
+
+    for (auto &entry : scoredByClass)
+    {
+        auto positivesIt = referenceCount.find(entry.first);
+        if (positivesIt == referenceCount.end())
+        {
+            extraDetections[entry.first] = static_cast<int>(entry.second.size());
+            continue;
+        }
+        int positives = positivesIt->second;
+
+        std::vector<Scored> &scored = entry.second;
+        std::sort(scored.begin(), scored.end(), [](const Scored &a, const Scored &b) { return a.confidence > b.confidence; });
+
+        std::vector<double> precision, recall;
+        int tp = 0;
+        for (size_t i = 0; i < scored.size(); ++i)
+        {
+            tp += scored[i].truePositive ? 1 : 0;
+            precision.push_back(static_cast<double>(tp) / (i + 1));
+            recall.push_back(static_cast<double>(tp) / positives);
+        }
+
+        // Precision envelope, then area under the step curve
+        for (int i = static_cast<int>(precision.size()) - 2; i >= 0; --i)
+            precision[i] = std::max(precision[i], precision[i + 1]);
+
+        double ap = 0.0, previousRecall = 0.0;
+        for (size_t i = 0; i < precision.size(); ++i)
+        {
+            ap += (recall[i] - previousRecall) * precision[i];
+            previousRecall = recall[i];
+        }
+        apByClass[entry.first] = ap;
+    }
+
+    return apByClass;
+}
+
+size_t countDetections(const RunResult &run)
+{
+    size_t total = 0;
+    for (const auto &frame : run.detections)
+        total += frame.size();
+    return total;
+}
+
+void printLatency(const std::string &label, const RunResult &run)
+{
+    std::cout << "  " << std::left << std::setw(6) << label << std::right << std::fixed << std::setprecision(2)
+              << " p50 " << std::setw(8) << percentile(run.latenciesMs, 0.50) << " ms"
+              << "   p90 " << std::setw(8) << percentile(run.latenciesMs, 0.90) << " ms"
+              << "   p99 " << std::setw(8) << percentile(run.latenciesMs, 0.99) << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string fp32Path, quantPath, framesDir, classesPath;
+    BackendOptions options;
+    double iouThreshold = 0.5;
+    int warmupPasses = 3;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--fp32" && i + 1 < argc)
+            fp32Path = argv[++i];
+        else if (arg == "--quant" && i + 1 < argc)
+            quantPath = argv[++i];
+        else if (arg == "--frames" && i + 1 < argc)
+            framesDir = argv[++i];
+        else if (arg == "--classes" && i + 1 < argc)
+            classesPath = argv[++i];
+        else if (arg == "--backend" && i + 1 < argc)
+            options.type = backendTypeFromString(argv[++i]);
+        else if (arg == "--iou" && i + 1 < argc)
+            iouThreshold = std::stod(argv[++i]);
+        else if (arg == "--warmup" && i + 1 < argc)
+            warmupPasses = std::max(0, std::stoi(argv[++i]));
+    }
+
+    if (fp32Path.empty() || quantPath.empty() || framesDir.empty())
+    {
+        std::cerr << "Usage: " << argv[0] << " --fp32 <model.onnx> --quant <model_int8.onnx> --frames <dir>"
+                  << " [--backend opencv|onnxruntime] [--classes classes.txt] [--iou 0.5] [--warmup 3]" << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> files;
+    for (const char *pattern : {"/*.jpg", "/*.jpeg", "/*.png", "/*.bmp"})
+    {
+        std::vector<std::string> matches;
+        cv::glob(framesDir + pattern, matches, false);
+        files.insert(files.end(), matches.begin(), matches.end());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<cv::Mat> frames;
+    for (const auto &file : files)
+    {
+        cv::Mat frame = cv::imread(file);
+        if (!frame.empty())
+            frames.push_back(frame);
+    }
+    if (frames.empty())
+    {
+        std::cerr << "Error: no images found in " << framesDir << std::endl;
+        return -1;
+    }
+
+    std::vector<std::string> classNames = Inference::readClassNames(classesPath);
+
+    RunResult reference, quantized;
+    try
+    {
+        std::cout << "Running " << frames.size() << " frames through both models..." << std::endl;
+        reference = runModel(fp32Path, classNames, options, frames, warmupPasses);
+        quantized = runModel(quantPath, classNames, options, frames, warmupPasses);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+
+    std::cout << "\nLatency (" << frames.size() << " frames, preprocessing + inference + NMS)" << std::endl;
+    printLatency(reference.precision, reference);
+    printLatency(quantized.precision, quantized);
+    double speedup = percentile(quantized.latenciesMs, 0.5) > 0
+                         ? percentile(reference.latenciesMs, 0.5) / percentile(quantized.latenciesMs, 0.5)
+                         : 0.0;
+    std::cout << "  median speed-up: x" << std::setprecision(2) << speedup << std::endl;
+
+    size_t referenceTotal = countDetections(reference);
+    size_t quantizedTotal = countDetections(quantized);
+    size_t framesWithDifferentCount = 0;
+    for (size_t f = 0; f < frames.size(); ++f)
+    {
+        if (reference.detections[f].size() != quantized.detections[f].size())
+            ++framesWithDifferentCount;
+    }
+
+    std::cout << "\nDetections" << std::endl;
+    std::cout << "  " << reference.precision << ": " << referenceTotal << " ("
+              << static_cast<double>(referenceTotal) / frames.size() << " / frame)" << std::endl;
+    std::cout << "  " << quantized.precision << ": " << quantizedTotal << " ("
+              << static_cast<double>(quantizedTotal) / frames.size() << " / frame)" << std::endl;
+    std::cout << "  delta: " << static_cast<long long>(quantizedTotal) - static_cast<long long>(referenceTotal)
+              << ", frames with a different count: " << framesWithDifferentCount << std::endl;
+
+    std::map<int, int> extraDetections;
+    std::map<int, double> apByClass =
+        averagePrecision(reference.detections, quantized.detections, iouThreshold, extraDetections);
+    auto className = [&classNames](int classId) {
+        return classId < static_cast<int>(classNames.size()) ? classNames[classId] : "class_" + std::to_string(classId);
+    };
+
+    double meanAp = 0.0;
+    std::cout << "\nAgreement with " << reference.precision << " (AP@" << iouThreshold << ")" << std::endl;
+    for (const auto &entry : apByClass)
+    {
+        std::cout << "  " << std::left << std::setw(20) << className(entry.first) << std::right
+                  << std::setprecision(3) << entry.second << std::endl;
+        meanAp += entry.second;
+    }
+    if (!apByClass.empty())
+        meanAp /= apByClass.size();
+    std::cout << "  mAP: " << std::setprecision(3) << meanAp << " over " << apByClass.size() << " class(es)" << std::endl;
+
+    if (!extraDetections.empty())
+    {
+        // No reference boxes, so every one is a false positive; reported apart instead of as AP 0
+        std::cout << "\nClasses only " << quantized.precision << " detected (false positives, not in mAP)" << std::endl;
+        for (const auto &entry : extraDetections)
+            std::cout << "  " << std::left << std::setw(20) << className(entry.first) << std::right << entry.second << std::endl;
+    }
+
+    return 0;
+}
@@ -5,10 +5,11 @@
 #include <opencv2/opencv.hpp>
 #include <vector>
 
-// Convert YOLO Detection to ByteTrack Object
-inline std::vector<byte_track::Object> convertToByteTrackObjects(const std::vector<Detection>& detections)
+// Convert YOLO Detection to ByteTrack Object, into a reusable buffer (cleared first)
+inline void convertToByteTrackObjects(const std::vector<Detection>& detections,
+                                      std::vector<byte_track::Object>& objects)
 {
-    std::vector<byte_track::Object> objects;
+    objects.clear();
     objects.reserve(detections.size());
 
     for (const auto& det : detections)
@@ -25,7 +26,13 @@ inline std::vector<byte_track::Object> convertToByteTrackObjects(const std::vect
         byte_track::Object obj(rect, det.class_id, det.confidence);
         objects.push_back(obj);
     }
+}
 
+// Convert YOLO Detection to ByteTrack Object
+inline std::vector<byte_track::Object> convertToByteTrackObjects(const std::vector<Detection>& detections)
+{
+    std::vector<byte_track::Object> objects;
+    convertToByteTrackObjects(detections, objects);
     return objects;
 }
 